@@ -1,14 +1,18 @@
 #include <LPC17xx.h>
-#include <stdio.h>
 #include <math.h>
+#include "ramfunc.h"
 
 // LCD connections on CND port
 #define LCD_DATA_MASK (0xF << 23) // P0.23 to P0.26 as D4–D7
 #define LCD_RS (1 << 27)          // P0.27
 #define LCD_EN (1 << 28)          // P0.28
+#define LCD_COLS 16
 
-char lcdBuffer[32];
-float v4, v5, diff;
+// Differential mode: AD0.4/AD0.5 pairs taken from the same BURST scan
+#define DIFF_WINDOW 64            // pairs per displayed result
+
+char lcd_line[LCD_COLS + 1];
+unsigned int diff_min, diff_max, diff_rms; // |V4 - V5| in 0.01 V over the window
 unsigned int adc4, adc5;
 
 // ---------- Delay Functions ----------
@@ -18,10 +22,18 @@ void delay(unsigned int count)
     for (i = 0; i < count; i++);
 }
 
+// TIMER0 prescale for one tick per 1/hz s, from its PCLK (PCLKSEL0 bits 3:2)
+unsigned int tim0_prescale(unsigned int hz)
+{
+    static const unsigned char pclkdiv[4] = { 4, 1, 2, 8 };
+    unsigned int pclk = SystemCoreClock / pclkdiv[(LPC_SC->PCLKSEL0 >> 2) & 3];
+    return (pclk + hz / 2) / hz - 1;
+}
+
 void delayUS(unsigned int us)
 {
     LPC_TIM0->TCR = 0x02; // reset timer
-    LPC_TIM0->PR = 24;    // prescaler for 1µs tick @ 25MHz PCLK
+    LPC_TIM0->PR = tim0_prescale(1000000);   // 1 µs tick at the current PCLK
     LPC_TIM0->TCR = 0x01; // start
     while (LPC_TIM0->TC < us);
     LPC_TIM0->TCR = 0x00; // stop timer
@@ -93,16 +105,51 @@ void lcd_string(char *str)
         lcd_data(*str++);
 }
 
-// ---------- ADC Function ----------
-unsigned int read_adc(unsigned int channel)
+#include "lcd_format.h"           // bounded row formatter (replaces sprintf)
+
+// ---------- ADC Functions ----------
+void adc_burst_init(void)
+{
+    LPC_ADC->ADCR = (1 << 4) | (1 << 5) | // AD0.4 + AD0.5 in every scan
+                    (4 << 8)  |           // clkdiv
+                    (1 << 16) |           // BURST: free-running scans
+                    (1 << 21);            // enable
+}
+
+// Both results come from one scan: AD0.5 is the last channel, so its DONE
+// marks the end of a scan, and ADDR4 still holds that scan's AD0.4 until
+// the next scan finishes converting it (one conversion time later).
+RAMFUNC void read_adc_pair(unsigned int *a4, unsigned int *a5)
+{
+    unsigned int r4, r5;
+
+    (void)LPC_ADC->ADDR5;                           // clear stale DONE
+    while (!((r5 = LPC_ADC->ADDR5) & (1U << 31)));  // end of a fresh scan
+    r4 = LPC_ADC->ADDR4;                            // AD0.4 of the same scan
+
+    *a4 = (r4 >> 4) & 0xFFF;
+    *a5 = (r5 >> 4) & 0xFFF;
+}
+
+// Collect DIFF_WINDOW pairs and reduce |V4 - V5| to min / max / RMS
+void measure_diff_window(void)
 {
-    unsigned int result;
-    LPC_ADC->ADCR = (1 << channel) | (4 << 8) | (1 << 21); // select ch, clkdiv, enable
-    LPC_ADC->ADCR |= (1 << 24); // start conversion
-    while (!(LPC_ADC->ADGDR & (1U << 31))); // wait for done
-    result = (LPC_ADC->ADGDR >> 4) & 0xFFF; // get 12-bit result
-    LPC_ADC->ADCR &= ~(7 << 24); // stop conversion
-    return result;
+    unsigned int n, d, dmin = 0xFFF, dmax = 0;
+    unsigned long sumsq = 0;
+
+    for (n = 0; n < DIFF_WINDOW; n++)
+    {
+        read_adc_pair(&adc4, &adc5);
+        d = (adc4 > adc5) ? adc4 - adc5 : adc5 - adc4;
+        if (d < dmin) dmin = d;
+        if (d > dmax) dmax = d;
+        sumsq += (unsigned long)d * d;              // < 2^32 for 64 pairs
+    }
+
+    // Counts -> hundredths of a volt (3.30 V full scale)
+    diff_min = (dmin * 330 + 2047) / 4095;
+    diff_max = (dmax * 330 + 2047) / 4095;
+    diff_rms = ((unsigned int)sqrtf((float)sumsq / DIFF_WINDOW) * 330 + 2047) / 4095;
 }
 
 // ---------- MAIN ----------
@@ -118,26 +165,21 @@ int main(void)
     // ADC setup (AD0.4 on P1.30 and AD0.5 on P1.31)
     LPC_PINCON->PINSEL3 |= (3 << 28) | (3 << 30); // set P1.30, P1.31 as AD0.4, AD0.5
     LPC_SC->PCONP |= (1 << 12); // power up ADC block
+    adc_burst_init();
 
     while (1)
     {
-        // Read both channels
-        adc4 = read_adc(4);
-        adc5 = read_adc(5);
-
-        // Convert to voltage
-        v4 = (adc4 * 3.3f) / 4095.0f;
-        v5 = (adc5 * 3.3f) / 4095.0f;
-        diff = fabsf(v4 - v5);
+        // Paired samples of both channels, reduced over the window
+        measure_diff_window();
 
         // Display on LCD
         lcd_command(0x80); // Line 1
-        sprintf(lcdBuffer, "ADC4:%4u ADC5:%4u", adc4, adc5);
-        lcd_string(lcdBuffer);
+        lcd_format(lcd_line, "A4:%4u A5:%4u", adc4, adc5);
+        lcd_string(lcd_line);
 
         lcd_command(0xC0); // Line 2
-        sprintf(lcdBuffer, "Diff: %.2f V   ", diff);
-        lcd_string(lcdBuffer);
+        lcd_format(lcd_line, "%.2u-%.2u R%.2uV", diff_min, diff_max, diff_rms);
+        lcd_string(lcd_line);
 
         delay(1000000);
     }
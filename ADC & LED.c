@@ -3,11 +3,20 @@
 
 #define LED_MASK   (0xFF << 4)    // LEDs on P0.4 – P0.11 (CNA)
 
+// OUTPUT_SHIFTREG = 1: LEDs on a 74HC595 fed from SSP0 instead of 8 GPIOs
+//   SCK0 P0.15 -> SRCLK, MOSI0 P0.18 -> SER, P0.16 (GPIO) -> RCLK
+// One byte fits the SSP FIFO, so an update is a single DR write + latch.
+#define OUTPUT_SHIFTREG 0
+#define SR_LATCH   (1 << 16)      // P0.16 → RCLK
+
 // ---------- Function Prototypes ----------
 void delay_ms(unsigned int);
+unsigned int tim0_prescale(unsigned int hz);
 unsigned int read_adc(void);
 void ring_counter(void);
 void johnson_counter(void);
+void led_init(void);
+void led_write(uint8_t val);
 
 // ---------- Global Variables ----------
 unsigned int adc_val;
@@ -21,8 +30,8 @@ int main(void)
     SystemInit();
     SystemCoreClockUpdate();
 
-    // ---------- LED setup (CNA connector) ----------
-    LPC_GPIO0->FIODIR |= LED_MASK;      // P0.4–P0.11 as output
+    // ---------- LED setup (CNA connector or shift register) ----------
+    led_init();
 
     // ---------- ADC setup on P1.30 (AD0.4) ----------
     LPC_PINCON->PINSEL3 |= (3 << 28);   // P1.30 → AD0.4 (function 11)
@@ -64,8 +73,7 @@ void ring_counter(void)
     uint32_t val = 0x01;
     for (int i = 0; i < 8; i++)
     {
-        LPC_GPIO0->FIOCLR = LED_MASK;        // Clear all LEDs
-        LPC_GPIO0->FIOSET = (val << 4);      // Set one LED
+        led_write(val);                      // One LED on
         delay_ms(200);
         val <<= 1;
         if (val == 0x100) val = 0x01;        // Restart after 8 bits
@@ -83,8 +91,7 @@ void johnson_counter(void)
     for (int i = 0; i < 8; i++)
     {
         val = (val >> 1) | 0x80;             // Shift right, insert 1
-        LPC_GPIO0->FIOCLR = LED_MASK;
-        LPC_GPIO0->FIOSET = (val << 4);
+        led_write(val);
         delay_ms(200);
     }
 
@@ -92,19 +99,60 @@ void johnson_counter(void)
     for (int i = 0; i < 8; i++)
     {
         val >>= 1;                            // Shift right, insert 0
-        LPC_GPIO0->FIOCLR = LED_MASK;
-        LPC_GPIO0->FIOSET = (val << 4);
+        led_write(val);
         delay_ms(200);
     }
 }
 
+// =====================================================
+// FUNCTION: LED OUTPUT (GPIO or 74HC595 on SSP0)
+// =====================================================
+void led_init(void)
+{
+#if OUTPUT_SHIFTREG
+    LPC_SC->PCONP |= (1 << 21);                                            // Power SSP0
+    LPC_PINCON->PINSEL0 = (LPC_PINCON->PINSEL0 & ~(3u << 30)) | (2u << 30); // P0.15 SCK0
+    LPC_PINCON->PINSEL1 = (LPC_PINCON->PINSEL1 & ~(3 << 4)) | (2 << 4);     // P0.18 MOSI0
+    LPC_GPIO0->FIODIR |= SR_LATCH;
+    LPC_SSP0->CR0  = 0x07;                   // 8-bit SPI
+    LPC_SSP0->CPSR = 2;                      // SCK = PCLK/2
+    LPC_SSP0->CR1  = (1 << 1);               // Enable, master
+#else
+    LPC_GPIO0->FIODIR |= LED_MASK;           // P0.4–P0.11 as output
+#endif
+}
+
+void led_write(uint8_t val)
+{
+#if OUTPUT_SHIFTREG
+    LPC_SSP0->DR = val;
+    while (LPC_SSP0->SR & (1 << 4));         // 8 bits at 12.5 MHz
+    LPC_GPIO0->FIOSET = SR_LATCH;            // RCLK pulse
+    LPC_GPIO0->FIOCLR = SR_LATCH;
+#else
+    LPC_GPIO0->FIOCLR = LED_MASK;            // Clear all LEDs
+    LPC_GPIO0->FIOSET = ((uint32_t)val << 4);
+#endif
+}
+
+// =====================================================
+// FUNCTION: TIMER0 PRESCALE (one tick per 1/hz s at the
+//           PCLK selected in PCLKSEL0 bits 3:2)
+// =====================================================
+unsigned int tim0_prescale(unsigned int hz)
+{
+    static const unsigned char pclkdiv[4] = { 4, 1, 2, 8 };
+    unsigned int pclk = SystemCoreClock / pclkdiv[(LPC_SC->PCLKSEL0 >> 2) & 3];
+    return (pclk + hz / 2) / hz - 1;
+}
+
 // =====================================================
 // FUNCTION: TIMER0 DELAY (Accurate millisecond delay)
 // =====================================================
 void delay_ms(unsigned int milliseconds)
 {
     LPC_TIM0->TCR = 0x02;     // Reset Timer
-    LPC_TIM0->PR  = 2999;     // Prescale for 1 ms (100 MHz CCLK → 25 MHz PCLK)
+    LPC_TIM0->PR  = tim0_prescale(1000);  // 1 ms tick at the current PCLK
     LPC_TIM0->TCR = 0x01;     // Enable Timer
     while (LPC_TIM0->TC < milliseconds);
     LPC_TIM0->TCR = 0x00;     // Disable Timer
@@ -1,20 +1,43 @@
 #include <LPC17xx.h>
 #include <math.h>
 #include <stdint.h>
+#include "ramfunc.h"
+#include "isr_stats.h"
 
 #define SEGMENT_MASK (0xFF << 4)      // P0.4–P0.11 → segments (CNA)
 #define DIGIT_MASK   (0x0F << 23)     // P1.23–P1.26 → digit select (CNB)
+#define DIFF_WINDOW  64               // AD0.4/AD0.5 pairs per displayed value
+
+// OUTPUT_SHIFTREG = 1: segments, digits and an 8-LED bar are driven from a
+// chain of 74HC595s on SSP0 instead of 12 GPIO pins. Each digit has its own
+// '595, so the display is static (no multiplexing) and a whole frame is one
+// GPDMA transfer to SSP0; the CPU only builds the frame and kicks the DMA.
+//   SCK0  P0.15 -> SRCLK (all)    MOSI0 P0.18 -> SER of the first '595
+//   P0.16 (GPIO) -> RCLK (all)    QH' of each '595 -> SER of the next
+// First byte out ends up in the last '595 of the chain.
+#ifndef OUTPUT_SHIFTREG
+#define OUTPUT_SHIFTREG 0
+#endif
+#define SR_LATCH     (1 << 16)        // P0.16 → RCLK
+#define SR_FRAME_LEN 5                // LED bar + 4 digits
 
 // ----------- Function Prototypes ------------------
 void delay_ms(unsigned int);
-unsigned int read_adc(uint8_t channel);
+unsigned int tim0_prescale(unsigned int hz);
+RAMFUNC void read_adc_pair(unsigned int *a4, unsigned int *a5);
+unsigned int diff_rms_window(void);
 void display_number(unsigned int num);
-void display_digit(uint8_t digit, uint8_t pos);
+RAMFUNC void display_digit(uint8_t digit, uint8_t pos);
+void sr_init(void);
+void sr_show(unsigned int num, uint8_t bar);
 
 // ----------- Global Variables ---------------------
 float v4, v5, diff;
 unsigned int adc4, adc5;
 unsigned int disp_val;
+uint8_t sr_frame[SR_FRAME_LEN];       // DMA source: [LED bar, d3, d2, d1, d0]
+volatile uint8_t sr_busy = 0;
+ISR_STATS_DEF(dmaStats, "GPDMA '595 latch");  // exit cycles only
 
 // 7-segment lookup (common cathode → segments active HIGH)
 uint8_t seg_code[10] = {
@@ -38,47 +61,69 @@ int main(void)
     SystemInit();
     SystemCoreClockUpdate();
 
+#if OUTPUT_SHIFTREG
+    sr_init();                         // SSP0 + GPDMA → 74HC595 chain
+#else
     // -------- 7-Segment Setup (CNA + CNB) --------
     LPC_GPIO0->FIODIR |= SEGMENT_MASK; // P0.4–P0.11 → output
     LPC_GPIO1->FIODIR |= DIGIT_MASK;   // P1.23–P1.26 → output
+#endif
 
     // -------- ADC Setup (AD0.4 + AD0.5) ----------
     LPC_PINCON->PINSEL3 |= (3 << 28) | (3 << 30); // P1.30→AD0.4, P1.31→AD0.5
     LPC_SC->PCONP |= (1 << 12);                   // Power up ADC
-    LPC_ADC->ADCR = (1 << 21) | (4 << 8);         // Enable ADC, clk = PCLK/5
+    LPC_ADC->ADCR = (1 << 4) | (1 << 5) |         // AD0.4 + AD0.5 each scan
+                    (1 << 16) |                   // BURST mode
+                    (1 << 21) | (4 << 8);         // Enable ADC, clk = PCLK/5
 
     while (1)
     {
-        adc4 = read_adc(4);
-        adc5 = read_adc(5);
-
-        v4 = (adc4 * 3.3f) / 4095.0f;
-        v5 = (adc5 * 3.3f) / 4095.0f;
-        diff = fabsf(v4 - v5);                    // |V4 - V5|
+        diff = (diff_rms_window() * 3.3f) / 4095.0f; // RMS of |V4 - V5|
 
         disp_val = (unsigned int)(diff * 100);    // Convert to hundredths
 
-        // Multiplex display for ~0.5s
-        for (int i = 0; i < 100; i++)
+#if OUTPUT_SHIFTREG
+        // Static display: one frame per value, bar = 0..8 LEDs over 0–3.3 V
+        sr_show(disp_val, (uint8_t)((1u << ((disp_val * 8 + 165) / 330)) - 1));
+        delay_ms(500);
+#else
+        // Multiplex display for ~0.5s (40 x 4 digits x 3 ms)
+        for (int i = 0; i < 40; i++)
         {
             display_number(disp_val);
         }
+#endif
     }
 }
 
 // =====================================================
-// FUNCTION: READ ADC VALUE (Channel AD0.x)
+// FUNCTION: READ AD0.4/AD0.5 FROM THE SAME BURST SCAN
 // =====================================================
-unsigned int read_adc(uint8_t channel)
+RAMFUNC void read_adc_pair(unsigned int *a4, unsigned int *a5)
 {
-    unsigned int result;
-    LPC_ADC->ADCR &= ~(0x7);           // Clear previous channel
-    LPC_ADC->ADCR |= (1 << channel);   // Select channel
-    LPC_ADC->ADCR |= (1 << 24);        // Start conversion
-    while ((LPC_ADC->ADGDR & (1 << 31)) == 0); // Wait for DONE
-    result = (LPC_ADC->ADGDR >> 4) & 0xFFF;
-    LPC_ADC->ADCR &= ~(7 << 24);       // Stop conversion
-    return result;
+    unsigned int r4, r5;
+    (void)LPC_ADC->ADDR5;                          // Clear stale DONE
+    while (!((r5 = LPC_ADC->ADDR5) & (1U << 31))); // AD0.5 done = end of scan
+    r4 = LPC_ADC->ADDR4;                           // AD0.4 of the same scan
+    *a4 = (r4 >> 4) & 0xFFF;
+    *a5 = (r5 >> 4) & 0xFFF;
+}
+
+// =====================================================
+// FUNCTION: RMS OF |ADC4 - ADC5| OVER DIFF_WINDOW PAIRS
+// =====================================================
+unsigned int diff_rms_window(void)
+{
+    unsigned long sumsq = 0;
+    unsigned int d;
+
+    for (int n = 0; n < DIFF_WINDOW; n++)
+    {
+        read_adc_pair(&adc4, &adc5);
+        d = (adc4 > adc5) ? adc4 - adc5 : adc5 - adc4;
+        sumsq += (unsigned long)d * d;
+    }
+    return (unsigned int)sqrtf((float)sumsq / DIFF_WINDOW);
 }
 
 // =====================================================
@@ -102,7 +147,7 @@ void display_number(unsigned int num)
 // =====================================================
 // FUNCTION: DISPLAY SINGLE DIGIT (COMMON-CATHODE)
 // =====================================================
-void display_digit(uint8_t digit, uint8_t pos)
+RAMFUNC void display_digit(uint8_t digit, uint8_t pos)
 {
     LPC_GPIO0->FIOCLR = SEGMENT_MASK; // clear old segments
     LPC_GPIO1->FIOCLR = DIGIT_MASK;   // turn off all digits
@@ -111,13 +156,91 @@ void display_digit(uint8_t digit, uint8_t pos)
     LPC_GPIO1->FIOSET = (1 << (23 + pos));      // enable one digit (active high)
 }
 
+// =====================================================
+// FUNCTION: SSP0 + GPDMA SETUP FOR THE 74HC595 CHAIN
+// =====================================================
+void sr_init(void)
+{
+    LPC_SC->PCONP |= (1 << 21) | (1 << 29);       // Power SSP0 + GPDMA
+
+    LPC_PINCON->PINSEL0 = (LPC_PINCON->PINSEL0 & ~(3u << 30)) | (2u << 30); // P0.15 SCK0
+    LPC_PINCON->PINSEL1 = (LPC_PINCON->PINSEL1 & ~(3 << 4)) | (2 << 4);     // P0.18 MOSI0
+    LPC_GPIO0->FIODIR |= SR_LATCH;
+    LPC_GPIO0->FIOCLR = SR_LATCH;
+
+    LPC_SSP0->CR0  = 0x07;                        // 8-bit SPI, CPOL 0, CPHA 0
+    LPC_SSP0->CPSR = 2;                           // SCK = PCLK/2 = 12.5 MHz
+    LPC_SSP0->DMACR = (1 << 1);                   // TX DMA request
+    LPC_SSP0->CR1  = (1 << 1);                    // Enable, master
+
+    LPC_GPDMA->DMACConfig = 1;                    // Enable GPDMA, little endian
+    LPC_GPDMA->DMACIntTCClear = 0xFF;
+    LPC_GPDMA->DMACIntErrClr  = 0xFF;
+    isr_stats_start();
+    NVIC_EnableIRQ(DMA_IRQn);
+}
+
+// =====================================================
+// FUNCTION: QUEUE ONE FRAME (one DMA transfer)
+// =====================================================
+void sr_show(unsigned int num, uint8_t bar)
+{
+    while (sr_busy);                              // Previous frame still going
+
+    sr_frame[0] = bar;
+    sr_frame[1] = seg_code[(num / 1000) % 10];
+    sr_frame[2] = seg_code[(num / 100) % 10];
+    sr_frame[3] = seg_code[(num / 10) % 10];
+    sr_frame[4] = seg_code[num % 10];
+    sr_busy = 1;
+
+    LPC_GPDMACH0->DMACCSrcAddr  = (uint32_t)sr_frame;
+    LPC_GPDMACH0->DMACCDestAddr = (uint32_t)&LPC_SSP0->DR;
+    LPC_GPDMACH0->DMACCLLI      = 0;
+    LPC_GPDMACH0->DMACCControl  = SR_FRAME_LEN    // Transfer size
+                                | (1u << 26)      // Source increment
+                                | (1u << 31);     // TC interrupt
+    LPC_GPDMACH0->DMACCConfig   = 1               // Channel enable
+                                | (0 << 6)        // Dest: SSP0 TX
+                                | (1 << 11)       // Memory → peripheral
+                                | (1 << 15);      // TC interrupt unmasked
+}
+
+// =====================================================
+// INTERRUPT HANDLER: FRAME SENT → LATCH THE '595s
+// =====================================================
+void DMA_IRQHandler(void)
+{
+    ISR_ENTRY(t0);
+    LPC_GPDMA->DMACIntTCClear = 0x01;
+    LPC_GPDMA->DMACIntErrClr  = 0x01;
+    // The frame fits the 8-entry TX FIFO, so TC fires with all of it still
+    // to shift: 5 x 8 bits at 12.5 MHz = 3.2 µs
+    while (LPC_SSP0->SR & (1 << 4));
+    LPC_GPIO0->FIOSET = SR_LATCH;                 // RCLK rising edge
+    LPC_GPIO0->FIOCLR = SR_LATCH;
+    sr_busy = 0;
+    ISR_EXIT(dmaStats, ISR_LAT_NONE, t0);
+}
+
+// =====================================================
+// FUNCTION: TIMER0 PRESCALE (one tick per 1/hz s at the
+//           PCLK selected in PCLKSEL0 bits 3:2)
+// =====================================================
+unsigned int tim0_prescale(unsigned int hz)
+{
+    static const unsigned char pclkdiv[4] = { 4, 1, 2, 8 };
+    unsigned int pclk = SystemCoreClock / pclkdiv[(LPC_SC->PCLKSEL0 >> 2) & 3];
+    return (pclk + hz / 2) / hz - 1;
+}
+
 // =====================================================
 // FUNCTION: DELAY USING TIMER0
 // =====================================================
 void delay_ms(unsigned int milliseconds)
 {
     LPC_TIM0->TCR = 0x02;    // reset timer
-    LPC_TIM0->PR  = 2999;    // 1 ms prescale (assuming 100 MHz CCLK)
+    LPC_TIM0->PR  = tim0_prescale(1000); // 1 ms tick at the current PCLK
     LPC_TIM0->TCR = 0x01;    // enable timer
     while (LPC_TIM0->TC < milliseconds);
     LPC_TIM0->TCR = 0x00;    // stop timer
@@ -0,0 +1,298 @@
+#include <LPC17xx.h>
+#include <stdint.h>
+#include "isr_stats.h"
+
+// LCD connections on CND port
+#define LCD_DATA_MASK (0xF << 23) // P0.23 to P0.26 as D4–D7
+#define LCD_RS (1 << 27)          // P0.27
+#define LCD_EN (1 << 28)          // P0.28
+#define LCD_COLS 16
+
+// Measured input: CAP2.0 on P0.4 (CNA). TIMER2 runs at CCLK, so one
+// tick is 10 ns at 100 MHz. Edges are captured alternately rising and
+// falling; the ISR only latches timestamps.
+#define CAP_PIN      (1 << 4)     // P0.4 = CAP2.0
+#define CAP_TIMEOUT  2000         // ms without edges -> report DC level
+
+// LOOPBACK = 1: generate PWM1.4 on P1.23 exactly as "LED & PWM.c" does
+// (MR0 = 30000) and jumper P1.23 -> P0.4 to check the measurement.
+#define LOOPBACK     1
+#define PWM_PERIOD   30000        // PWM1 MR0
+#define PWM_HIGH     7500         // PWM1 MR4, 25 % duty
+
+char lcd_line[LCD_COLS + 1];
+
+// Written by TIMER2_IRQHandler, read in main with interrupts off
+volatile uint32_t t_rise;         // TC at the last rising edge
+volatile uint32_t period_ticks;   // rising -> rising
+volatile uint32_t high_ticks;     // rising -> falling
+volatile uint32_t edge_count;
+volatile uint8_t  rise_count;     // saturates at 2: period valid
+
+uint32_t cap_clk;                 // TIMER2 input clock in Hz
+
+// Edge -> ISR entry from CR0 vs TC (TIMER2 ticks = CPU cycles), exit cycles
+ISR_STATS_DEF(timer2Stats, "TIMER2 capture");
+
+// ---------- Delay Functions ----------
+void delay(unsigned int count)
+{
+    unsigned int i;
+    for (i = 0; i < count; i++);
+}
+
+// TIMER0 prescale for one tick per 1/hz s, from its PCLK (PCLKSEL0 bits 3:2)
+unsigned int tim0_prescale(unsigned int hz)
+{
+    static const unsigned char pclkdiv[4] = { 4, 1, 2, 8 };
+    unsigned int pclk = SystemCoreClock / pclkdiv[(LPC_SC->PCLKSEL0 >> 2) & 3];
+    return (pclk + hz / 2) / hz - 1;
+}
+
+void delayUS(unsigned int us)
+{
+    LPC_TIM0->TCR = 0x02; // reset timer
+    LPC_TIM0->PR = tim0_prescale(1000000);   // 1 µs tick at the current PCLK
+    LPC_TIM0->TCR = 0x01; // start
+    while (LPC_TIM0->TC < us);
+    LPC_TIM0->TCR = 0x00; // stop timer
+}
+
+void initTimer0(void)
+{
+    LPC_SC->PCONP |= (1 << 1); // power on Timer0
+    LPC_TIM0->CTCR = 0x0;      // timer mode
+    LPC_TIM0->PR = 0;
+    LPC_TIM0->TCR = 0x02;      // reset timer
+}
+
+// ---------- LCD Functions ----------
+void lcd_pulse_enable(void)
+{
+    LPC_GPIO0->FIOSET = LCD_EN;
+    delayUS(1);
+    LPC_GPIO0->FIOCLR = LCD_EN;
+    delayUS(100);
+}
+
+void lcd_send_nibble(unsigned char nibble)
+{
+    LPC_GPIO0->FIOCLR = LCD_DATA_MASK;
+    LPC_GPIO0->FIOSET = ((nibble & 0x0F) << 23);
+    lcd_pulse_enable();
+}
+
+void lcd_send_byte(unsigned char byte, int is_data)
+{
+    if (is_data)
+        LPC_GPIO0->FIOSET = LCD_RS;
+    else
+        LPC_GPIO0->FIOCLR = LCD_RS;
+
+    lcd_send_nibble(byte >> 4);
+    lcd_send_nibble(byte & 0x0F);
+}
+
+void lcd_command(unsigned char cmd)
+{
+    lcd_send_byte(cmd, 0);
+    delay(2000);
+}
+
+void lcd_data(unsigned char data)
+{
+    lcd_send_byte(data, 1);
+    delay(2000);
+}
+
+void lcd_init(void)
+{
+    LPC_GPIO0->FIODIR |= LCD_DATA_MASK | LCD_RS | LCD_EN;
+    delay(30000);
+    lcd_command(0x33);
+    lcd_command(0x32);
+    lcd_command(0x28); // 4-bit, 2 line, 5x7 font
+    lcd_command(0x0C); // Display ON, cursor off
+    lcd_command(0x06); // Entry mode
+    lcd_command(0x01); // Clear display
+    delay(3000);
+}
+
+void lcd_string(char *str)
+{
+    while (*str)
+        lcd_data(*str++);
+}
+
+#include "lcd_format.h"           // bounded row formatter (replaces sprintf)
+
+// ---------- Capture Engine ----------
+void capture_init(void)
+{
+    LPC_SC->PCONP |= (1 << 22);                   // power on Timer2
+    LPC_SC->PCLKSEL1 = (LPC_SC->PCLKSEL1 & ~(3 << 12)) | (1 << 12); // PCLK = CCLK
+    cap_clk = SystemCoreClock;
+
+    LPC_PINCON->PINSEL0 |= (3 << 8);              // P0.4 as CAP2.0
+
+    LPC_TIM2->TCR  = 0x02;                        // reset timer
+    LPC_TIM2->CTCR = 0x0;                         // timer mode
+    LPC_TIM2->PR   = 0;                           // full resolution
+    LPC_TIM2->MCR  = 0;
+    LPC_TIM2->CCR  = (1 << 0) | (1 << 2);         // CAP2.0 rising + interrupt
+    LPC_TIM2->IR   = 0x3F;
+    LPC_TIM2->TCR  = 0x01;                        // start
+
+    isr_stats_start();
+    NVIC_EnableIRQ(TIMER2_IRQn);
+}
+
+void TIMER2_IRQHandler(void)
+{
+    ISR_ENTRY(t0);
+    uint32_t t = LPC_TIM2->CR0;
+    LPC_TIM2->IR = (1 << 4);                      // clear CR0 interrupt
+
+    if (LPC_TIM2->CCR & (1 << 0))                 // rising edge captured
+    {
+        period_ticks = t - t_rise;                // wrap-safe up to 42 s
+        t_rise = t;
+        if (rise_count < 2) rise_count++;
+        LPC_TIM2->CCR = (1 << 1) | (1 << 2);      // next: falling
+    }
+    else                                          // falling edge captured
+    {
+        high_ticks = t - t_rise;
+        LPC_TIM2->CCR = (1 << 0) | (1 << 2);      // next: rising
+    }
+    edge_count++;
+#if ISR_STATS
+    {
+        // TC now - CR0, less the cycles spent in here = TC at entry - CR0.
+        // TC and CYCCNT are read back to back.
+        uint32_t tc = LPC_TIM2->TC;
+        uint32_t t1 = DWT->CYCCNT;
+        ISR_EXIT(timer2Stats, (tc - t) - (t1 - t0), t0);
+    }
+#endif
+}
+
+// Snapshot of the ISR results, converted to display units
+typedef struct
+{
+    uint32_t freq_cHz;            // frequency, 0.01 Hz
+    uint32_t period_ns;
+    uint32_t width_ns;            // high time
+    uint32_t duty_pm;             // duty cycle, 0.1 %
+} capture_result;
+
+int capture_read(capture_result *r)
+{
+    uint32_t period, high;
+    uint8_t valid;
+
+    __disable_irq();
+    period = period_ticks;
+    high   = high_ticks;
+    valid  = (rise_count >= 2);
+    __enable_irq();
+
+    if (!valid || period == 0)
+        return 0;
+
+    r->freq_cHz  = (uint32_t)(((uint64_t)cap_clk * 100) / period);
+    r->period_ns = (uint32_t)(((uint64_t)period * 1000000000u) / cap_clk);
+    r->width_ns  = (uint32_t)(((uint64_t)high * 1000000000u) / cap_clk);
+    r->duty_pm   = (uint32_t)(((uint64_t)high * 1000) / period);
+    return 1;
+}
+
+#if LOOPBACK
+// ---------- PWM1.4 Reference Output (P1.23) ----------
+void pwm_init(void)
+{
+    LPC_SC->PCONP |= (1 << 6);                    // power up PWM1
+    LPC_PINCON->PINSEL3 &= ~(0x0000C000);
+    LPC_PINCON->PINSEL3 |=  (0x00008000);         // P1.23 as PWM1.4
+
+    LPC_PWM1->PCR = 0x00001000;                   // enable PWM1.4 output
+    LPC_PWM1->MCR = 0x00000002;                   // reset on MR0, no interrupt
+    LPC_PWM1->MR0 = PWM_PERIOD;
+    LPC_PWM1->MR4 = PWM_HIGH;
+    LPC_PWM1->LER = 0x000000FF;
+    LPC_PWM1->TCR = 0x00000002;
+    LPC_PWM1->TCR = 0x00000009;                   // counter + PWM mode
+}
+#endif
+
+// ---------- MAIN ----------
+int main(void)
+{
+    capture_result r;
+    uint32_t last_edges = 0, idle_ms = 0;
+#if LOOPBACK
+    uint32_t pwm_clk, exp_ns;
+    int err_ppm, err_duty;
+#endif
+
+    SystemInit();
+    SystemCoreClockUpdate();
+    initTimer0();
+    lcd_init();
+    capture_init();
+
+#if LOOPBACK
+    pwm_init();
+    pwm_clk = SystemCoreClock / 4;                // PWM1 PCLK = CCLK/4 (reset)
+    exp_ns  = (uint32_t)(((uint64_t)PWM_PERIOD * 1000000000u) / pwm_clk);
+#endif
+
+    while (1)
+    {
+        if (edge_count != last_edges)
+        {
+            last_edges = edge_count;
+            idle_ms = 0;
+        }
+        else if (idle_ms < CAP_TIMEOUT)
+            idle_ms += 250;
+
+        lcd_command(0x80); // Line 1
+        if (idle_ms >= CAP_TIMEOUT || !capture_read(&r))
+        {
+            lcd_format(lcd_line, "No edges");
+            lcd_string(lcd_line);
+            lcd_command(0xC0); // Line 2
+            lcd_format(lcd_line, (LPC_GPIO0->FIOPIN & CAP_PIN) ? "DC HIGH" : "DC LOW");
+            lcd_string(lcd_line);
+        }
+        else
+        {
+            lcd_format(lcd_line, "F:%12.2uHz", r.freq_cHz);
+            lcd_string(lcd_line);
+            lcd_command(0xC0); // Line 2
+#if LOOPBACK
+            // Period error against MR0 in ppm, duty error in 0.1 %
+            err_ppm  = (int)(((int64_t)r.period_ns - exp_ns) * 1000000 / (int64_t)exp_ns);
+            err_duty = (int)r.duty_pm - (int)((PWM_HIGH * 1000u) / PWM_PERIOD);
+            // Clamp so both fields fit: "dF-9999ppm D-9.9" is all 16 columns
+            if (err_ppm  < -9999) err_ppm  = -9999;
+            if (err_ppm  > 99999) err_ppm  = 99999;
+            if (err_duty < -99)   err_duty = -99;
+            if (err_duty > 999)   err_duty = 999;
+            lcd_format(lcd_line, "dF%5dppm D%4.1d", err_ppm, err_duty);
+#else
+            // 100.0 % (DC high just before the timeout) would need a
+            // fifth digit and push the unit off the row: show 99.9 %
+            if (r.duty_pm > 999) r.duty_pm = 999;
+            if (r.width_ns < 10000000)            // < 10 ms: show us
+                lcd_format(lcd_line, "D%4.1u%% W%7.2uu", r.duty_pm, r.width_ns / 10);
+            else
+                lcd_format(lcd_line, "D%4.1u%% W%6um", r.duty_pm, r.width_ns / 1000000);
+#endif
+            lcd_string(lcd_line);
+        }
+
+        delayUS(250000);                          // 4 updates per second
+    }
+}
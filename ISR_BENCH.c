@@ -0,0 +1,448 @@
+#include <LPC17xx.h>
+#include <stdint.h>
+#include <stdio.h>               // sprintf, only for the formatter comparison
+#define ISR_STATS 1
+#include "isr_stats.h"           // same counters as the application ISRs
+#define LCD_COLS 16
+#include "lcd_format.h"
+
+// =========================================
+// INTERRUPT LATENCY / JITTER BENCHMARK
+// =========================================
+// Five interrupt sources run at unrelated rates while the main loop adds
+// background load. Every ISR records, in CPU cycles:
+//   latency : hardware event -> first instruction of the ISR
+//   exit    : first instruction -> last instruction (ISR body cost)
+// The benchmark walks all 31 on/off combinations of the sources, one
+// phase each, and prints count / min / max / mean per source over UART0
+// (P0.2, 115200 8N1), then a latency histogram for the all-on phase.
+//
+// How the event time is known:
+//   PWM   : PWM1 resets on MR0 and interrupts -> TC at entry = latency
+//   TIMER : TIMER1, same scheme on MR0
+//   ADC   : TIMER0 MAT0.1 starts AD0.0; TC at entry = latency + conversion
+//   GPIO  : TIMER2 MAT2.0 (P0.6) toggles, jumper P0.6 -> P0.0 (rising edge
+//           interrupt); TC at entry = latency + pin synchroniser
+//   UART  : UART1 in internal loopback; RX interrupt vs. time the byte was
+//           written, minus 9 bit times of the real divisor (RDA is set
+//           mid stop bit, so ~half a bit of constant offset remains)
+// All timers and PWM1 run from PCLK = CCLK, so one tick is one cycle.
+
+#define SRC_PWM    0
+#define SRC_TIMER  1
+#define SRC_ADC    2
+#define SRC_GPIO   3
+#define SRC_UART   4
+#define NUM_SRC    5
+
+#define PWM_PERIOD   10007         // cycles between events (primes, so
+#define TIMER_PERIOD 7919          // the sources drift against each
+#define ADC_PERIOD   9001          // other and every overlap is hit)
+#define GPIO_PERIOD  13001
+#define UART1_BAUD   115200
+
+#define PHASE_MS     500           // run time per source combination
+
+// Background load: busy copy plus a short IRQ-off window, like the
+// FIOMASK-guarded LCD write Project/code.c used to have
+#define BG_CRITICAL  1
+#define BG_CRIT_SPIN 16            // loop iterations with IRQs off
+
+// LCD nibble write of port_write() (Matrix & LCD.c, Project/code.c),
+// timed once before the phases on the same pins
+#define LCD_DT       0x07800000    // P0.23–P0.26 (P0.23 is AD0.0 later)
+#define LCD_RS       0x08000000    // P0.27
+#define LCD_EN       0x10000000    // P0.28
+#define NIBBLE_REPS  256
+
+#ifndef BITBAND_SRAM
+#define BITBAND_SRAM(addr, bit) \
+    (*(volatile uint32_t *)(0x22000000UL + \
+        (((uint32_t)(addr) - 0x20000000UL) << 5) + ((bit) << 2)))
+#endif
+#define LCD_EN_BB    BITBAND_SRAM(&LPC_GPIO0->FIOPIN, 28)
+
+ISR_STATS_SECTION isr_stats stats[NUM_SRC] = { { "PWM" }, { "TIMER" }, { "ADC" }, { "GPIO" }, { "UART" } };
+
+uint32_t uart_tx_t;                // DWT time the loopback byte was written
+uint32_t uart_char_cycles;         // THR write -> RDA, lower bound in cycles
+
+uint32_t bg_buf[2][64];            // background copy load
+
+// Function declarations
+void bench_init(void);
+void bench_lcd_nibble(void);
+void bench_lcd_format(void);
+void bench_enable(uint32_t mask);
+void bench_report(uint32_t mask, int with_hist);
+void uart0_init(void);
+void uart0_puts(const char *s);
+void uart0_putu(uint32_t v);
+
+// =========================================
+// RECORD ONE ISR EXECUTION (isr_stats.h)
+// =========================================
+#define bench_record(src, lat, t0) isr_stats_record(&stats[src], (lat), (t0))
+
+// =========================================
+// INTERRUPT HANDLERS
+// =========================================
+void PWM1_IRQHandler(void)
+{
+    uint32_t t0 = DWT->CYCCNT, lat = LPC_PWM1->TC;
+    LPC_PWM1->IR = 0xFF;
+    bench_record(SRC_PWM, lat, t0);
+}
+
+void TIMER1_IRQHandler(void)
+{
+    uint32_t t0 = DWT->CYCCNT, lat = LPC_TIM1->TC;
+    LPC_TIM1->IR = 0x3F;
+    bench_record(SRC_TIMER, lat, t0);
+}
+
+void ADC_IRQHandler(void)
+{
+    uint32_t t0 = DWT->CYCCNT, lat = LPC_TIM0->TC;
+    (void)LPC_ADC->ADDR0;                    // Clears DONE and the IRQ
+    bench_record(SRC_ADC, lat, t0);
+}
+
+void EINT3_IRQHandler(void)
+{
+    uint32_t t0 = DWT->CYCCNT, lat = LPC_TIM2->TC;
+    LPC_GPIOINT->IO0IntClr = (1 << 0);
+    bench_record(SRC_GPIO, lat, t0);
+}
+
+void UART1_IRQHandler(void)
+{
+    uint32_t t0 = DWT->CYCCNT, lat = t0 - uart_tx_t;
+    (void)LPC_UART1->RBR;                    // Clears RX data available
+    lat = (lat > uart_char_cycles) ? lat - uart_char_cycles : 0;
+    LPC_UART1->THR = 0x55;                   // Next loopback character
+    uart_tx_t = DWT->CYCCNT;
+    bench_record(SRC_UART, lat, t0);
+}
+
+// =========================================
+// MAIN FUNCTION
+// =========================================
+int main(void)
+{
+    uint32_t mask, t_end, i;
+
+    SystemInit();
+    SystemCoreClockUpdate();
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    uart0_init();
+    bench_init();
+    uart0_puts("\r\nISR bench: latency / exit in CPU cycles\r\n");
+    bench_lcd_nibble();                      // before the ADC takes P0.23
+    bench_lcd_format();
+
+    for(mask = 1; mask < (1 << NUM_SRC); mask++)
+    {
+        for(i = 0; i < NUM_SRC; i++)
+            isr_stats_reset(&stats[i]);
+
+        bench_enable(mask);
+        t_end = DWT->CYCCNT + (SystemCoreClock / 1000) * PHASE_MS;
+        while((int32_t)(DWT->CYCCNT - t_end) < 0)
+        {
+            for(i = 0; i < 64; i++)           // Background bus traffic
+                bg_buf[1][i] = bg_buf[0][i] + i;
+#if BG_CRITICAL
+            __disable_irq();                 // Interrupt-off window
+            for(i = 0; i < BG_CRIT_SPIN; i++) __NOP();
+            __enable_irq();
+#endif
+        }
+        bench_enable(0);
+
+        bench_report(mask, mask == (1 << NUM_SRC) - 1);
+    }
+
+    uart0_puts("done\r\n");
+    while(1);
+}
+
+// =========================================
+// FUNCTION: Configure all sources (IRQs still off)
+// =========================================
+void bench_init(void)
+{
+    // Timers + PWM1 on PCLK = CCLK (1 tick = 1 cycle)
+    LPC_SC->PCLKSEL0 = (LPC_SC->PCLKSEL0 & ~((3 << 2) | (3 << 4) | (3 << 12)))
+                     | (1 << 2) | (1 << 4) | (1 << 12);
+    LPC_SC->PCLKSEL1 = (LPC_SC->PCLKSEL1 & ~(3 << 12)) | (1 << 12);
+    LPC_SC->PCONP |= (1 << 1) | (1 << 2) | (1 << 4) | (1 << 6) | (1 << 12) | (1 << 22);
+
+    // -------- PWM1: reset + interrupt on MR0 --------
+    LPC_PWM1->TCR = 0x02;
+    LPC_PWM1->MR0 = PWM_PERIOD - 1;
+    LPC_PWM1->MCR = 0x03;
+    LPC_PWM1->LER = 0x01;
+    LPC_PWM1->TCR = 0x09;
+
+    // -------- TIMER1: reset + interrupt on MR0 --------
+    LPC_TIM1->TCR = 0x02;
+    LPC_TIM1->MR0 = TIMER_PERIOD - 1;
+    LPC_TIM1->MCR = 0x03;
+    LPC_TIM1->TCR = 0x01;
+
+    // -------- ADC: AD0.0 (P0.23) started by MAT0.1 rising edge --------
+    LPC_PINCON->PINSEL1 = (LPC_PINCON->PINSEL1 & ~(3 << 14)) | (1 << 14);
+    LPC_TIM0->TCR = 0x02;
+    LPC_TIM0->MR1 = ADC_PERIOD - 1;
+    LPC_TIM0->MCR = (1 << 4);                // Reset on MR1
+    LPC_TIM0->EMR = (3 << 6);                // Toggle MAT0.1
+    LPC_TIM0->TCR = 0x01;
+    LPC_ADC->ADCR = (1 << 0) | (1 << 8) | (1 << 21) | (4 << 24);
+    LPC_ADC->ADINTEN = (1 << 0);
+
+    // -------- GPIO: MAT2.0 on P0.6 -> jumper -> P0.0 rising edge --------
+    LPC_PINCON->PINSEL0 = (LPC_PINCON->PINSEL0 & ~((3 << 12) | 3)) | (3 << 12);
+    LPC_GPIO0->FIODIR &= ~(1 << 0);
+    LPC_TIM2->TCR = 0x02;
+    LPC_TIM2->MR0 = GPIO_PERIOD - 1;
+    LPC_TIM2->MCR = (1 << 1);                // Reset on MR0
+    LPC_TIM2->EMR = (3 << 4);                // Toggle MAT2.0
+    LPC_TIM2->TCR = 0x01;
+    LPC_GPIOINT->IO0IntEnR = (1 << 0);
+
+    // -------- UART1: internal loopback, RX interrupt --------
+    {
+        uint32_t div = (SystemCoreClock / 4) / (16 * UART1_BAUD);
+        LPC_UART1->LCR = 0x83;
+        LPC_UART1->DLL = div & 0xFF;
+        LPC_UART1->DLM = div >> 8;
+        LPC_UART1->LCR = 0x03;
+        LPC_UART1->FCR = 0x07;               // FIFOs on, RX trigger = 1 char
+        LPC_UART1->MCR = (1 << 4);           // Loopback
+        LPC_UART1->IER = (1 << 0);           // RX data available
+        // One bit = 16 * div UART1 PCLKs = 4 * 16 * div CPU cycles. The
+        // truncated div makes the real rate faster than UART1_BAUD.
+        uart_char_cycles = 9 * 16 * 4 * div;
+    }
+}
+
+// =========================================
+// FUNCTION: Enable the sources in mask, disable the rest
+// =========================================
+void bench_enable(uint32_t mask)
+{
+    static const IRQn_Type irq[NUM_SRC] = { PWM1_IRQn, TIMER1_IRQn, ADC_IRQn, EINT3_IRQn, UART1_IRQn };
+    uint32_t i;
+
+    for(i = 0; i < NUM_SRC; i++)
+    {
+        if(!(mask & (1 << i)))
+        {
+            NVIC_DisableIRQ(irq[i]);
+            continue;
+        }
+
+        // The peripheral flags stayed set while the source was off and
+        // would re-pend the IRQ with a stale timestamp: clear them first
+        switch(i)
+        {
+            case SRC_PWM:   LPC_PWM1->IR = 0xFF; break;
+            case SRC_TIMER: LPC_TIM1->IR = 0x3F; break;
+            case SRC_ADC:   (void)LPC_ADC->ADDR0; break;
+            case SRC_GPIO:  LPC_GPIOINT->IO0IntClr = (1 << 0); break;
+            case SRC_UART:
+                while(!(LPC_UART1->LSR & (1 << 6)));   // last byte fully out
+                while(LPC_UART1->LSR & 0x01) (void)LPC_UART1->RBR;
+                break;
+        }
+        NVIC_ClearPendingIRQ(irq[i]);
+        NVIC_EnableIRQ(irq[i]);
+    }
+
+    if(mask & (1 << SRC_UART))               // Prime the loopback chain
+    {
+        LPC_UART1->THR = 0x55;               // only byte in flight
+        uart_tx_t = DWT->CYCCNT;
+    }
+}
+
+// =========================================
+// FUNCTION: LCD nibble write cost, IRQs off, without the LCD delays
+//   FIOPIN  : original, whole-port store, then RS, EN up, EN down
+//   FIOMASK : masked nibble + RS store, EN up / down by bit-band
+//   CLR/SET : FIOCLR zeros, FIOSET ones + EN up, EN down by bit-band
+// Cycles per nibble, loop included (same loop for all three)
+// =========================================
+void bench_lcd_nibble(void)
+{
+    uint32_t n, v, t0, c[3];
+    const char *name[3] = { "FIOPIN", "FIOMASK", "CLR/SET" };
+
+    LPC_GPIO0->FIODIR |= LCD_DT | LCD_RS | LCD_EN;
+    __disable_irq();
+
+    t0 = DWT->CYCCNT;
+    for(n = 0; n < NIBBLE_REPS; n++)
+    {
+        LPC_GPIO0->FIOPIN = (n & 0xF) << 23;
+        if(n & 0x10) LPC_GPIO0->FIOSET = LCD_RS;
+        else         LPC_GPIO0->FIOCLR = LCD_RS;
+        LPC_GPIO0->FIOSET = LCD_EN;
+        LPC_GPIO0->FIOCLR = LCD_EN;
+    }
+    c[0] = DWT->CYCCNT - t0;
+
+    t0 = DWT->CYCCNT;
+    for(n = 0; n < NIBBLE_REPS; n++)
+    {
+        v = ((n & 0xF) << 23) | ((n & 0x10) ? LCD_RS : 0);
+        LPC_GPIO0->FIOMASK = ~(LCD_DT | LCD_RS);
+        LPC_GPIO0->FIOPIN  = v;
+        LPC_GPIO0->FIOMASK = 0;
+        LCD_EN_BB = 1;
+        LCD_EN_BB = 0;
+    }
+    c[1] = DWT->CYCCNT - t0;
+
+    t0 = DWT->CYCCNT;
+    for(n = 0; n < NIBBLE_REPS; n++)
+    {
+        v = ((n & 0xF) << 23) | ((n & 0x10) ? LCD_RS : 0);
+        LPC_GPIO0->FIOCLR = (LCD_DT | LCD_RS) & ~v;
+        LPC_GPIO0->FIOSET = v | LCD_EN;
+        LCD_EN_BB = 0;
+    }
+    c[2] = DWT->CYCCNT - t0;
+
+    __enable_irq();
+    LPC_GPIO0->FIOCLR = LCD_DT | LCD_RS | LCD_EN;
+    LPC_GPIO0->FIODIR &= ~(LCD_DT | LCD_RS | LCD_EN);
+
+    uart0_puts("LCD nibble write, cycles:");
+    for(n = 0; n < 3; n++)
+    {
+        uart0_puts(" ");      uart0_puts(name[n]);
+        uart0_puts(" ");      uart0_putu(c[n] / NIBBLE_REPS);
+        uart0_puts(".");      uart0_putu((c[n] * 10 / NIBBLE_REPS) % 10);
+    }
+    uart0_puts("\r\n");
+}
+
+// =========================================
+// FUNCTION: LCD row formatting cost, IRQs off
+//   lcd_format : "Val:%4u  %.2uV" with the voltage in hundredths
+//   sprintf    : "Val:%4u  %.2fV" with a float, as SILENT_INTRUDER_ALERT.c
+//                did (newlib-nano needs -u _printf_float for %f)
+// Cycles per row. Flash: lcd_format against _svfprintf_r, _dtoa_r and
+// the soft-float helpers in the .map of this build.
+// =========================================
+char fmt_row[32];
+
+void bench_lcd_format(void)
+{
+    uint32_t n, t0, c[2];
+    float volts;
+
+    __disable_irq();
+
+    t0 = DWT->CYCCNT;
+    for(n = 0; n < 64; n++)
+        lcd_format(fmt_row, "Val:%4u  %.2uV", 3890 + n, ((3890 + n) * 330 + 2047) / 4095);
+    c[0] = DWT->CYCCNT - t0;
+
+    t0 = DWT->CYCCNT;
+    for(n = 0; n < 64; n++)
+    {
+        volts = (3890 + n) * 3.3f / 4095;
+        sprintf(fmt_row, "Val:%4u  %.2fV", (unsigned int)(3890 + n), volts);
+    }
+    c[1] = DWT->CYCCNT - t0;
+
+    __enable_irq();
+
+    uart0_puts("LCD row format, cycles: lcd_format ");
+    uart0_putu(c[0] / 64);
+    uart0_puts(" sprintf ");
+    uart0_putu(c[1] / 64);
+    uart0_puts("\r\n");
+}
+
+// =========================================
+// FUNCTION: Print one phase
+// =========================================
+void bench_report(uint32_t mask, int with_hist)
+{
+    uint32_t i, b;
+
+    uart0_puts("phase ");
+    uart0_putu(mask);
+    uart0_puts("\r\n");
+
+    for(i = 0; i < NUM_SRC; i++)
+    {
+        isr_stats *s = &stats[i];
+        if(!(mask & (1 << i)) || s->count == 0)
+            continue;
+
+        uart0_puts("  ");
+        uart0_puts(s->name);
+        uart0_puts(" n=");     uart0_putu(s->count);
+        uart0_puts(" lat=");   uart0_putu(s->lat_min);
+        uart0_puts("..");      uart0_putu(s->lat_max);
+        uart0_puts(" mean=");  uart0_putu(s->lat_sum / s->count);
+        uart0_puts(" jitter="); uart0_putu(s->lat_max - s->lat_min);
+        uart0_puts(" exit=");  uart0_putu(s->exit_min);
+        uart0_puts("..");      uart0_putu(s->exit_max);
+        uart0_puts("\r\n");
+
+        if(with_hist)
+        {
+            for(b = 0; b <= ISR_HIST_BINS; b++)
+            {
+                if(!s->hist[b]) continue;
+                uart0_puts("    ");
+                uart0_putu(b << ISR_HIST_SHIFT);
+                uart0_puts(b == ISR_HIST_BINS ? "+ " : " ");
+                uart0_putu(s->hist[b]);
+                uart0_puts("\r\n");
+            }
+        }
+    }
+}
+
+// =========================================
+// FUNCTION: UART0 report output (polled)
+// =========================================
+void uart0_init(void)
+{
+    uint32_t div = (SystemCoreClock / 4) / (16 * 115200);
+    LPC_PINCON->PINSEL0 = (LPC_PINCON->PINSEL0 & ~(3 << 4)) | (1 << 4);   // P0.2 TXD0
+    LPC_UART0->LCR = 0x83;
+    LPC_UART0->DLL = div & 0xFF;
+    LPC_UART0->DLM = div >> 8;
+    LPC_UART0->LCR = 0x03;
+    LPC_UART0->FCR = 0x07;
+}
+
+void uart0_puts(const char *s)
+{
+    while(*s)
+    {
+        while(!(LPC_UART0->LSR & (1 << 5)));   // THR empty
+        LPC_UART0->THR = *s++;
+    }
+}
+
+void uart0_putu(uint32_t v)
+{
+    char buf[11];
+    int n = 10;
+    buf[n] = '\0';
+    do { buf[--n] = '0' + (v % 10); v /= 10; } while(v);
+    uart0_puts(&buf[n]);
+}
@@ -1,13 +1,24 @@
 #include <LPC17xx.h>
+#include <stdint.h>
+
+// ISR_IN_RAM = 0 builds PWM1_IRQHandler in flash (the "before" measurement)
+#define ISR_IN_RAM 1
+#include "ramfunc.h"
 
 // Function declarations
 void pwm_init(void);
+void flash_init(void);
 void PWM1_IRQHandler(void);
 
 // Global variables
 unsigned long int i;
 unsigned char flag = 0x00, flag1 = 0x00;
 
+// PWM1_IRQHandler timing, in CPU cycles (watch in the debugger)
+volatile uint32_t isr_cycles_min = 0xFFFFFFFF; // entry -> exit
+volatile uint32_t isr_cycles_max = 0;
+volatile uint32_t isr_latency_max = 0;         // MR0 match -> entry, PWM ticks
+
 // =========================================
 // MAIN FUNCTION
 // =========================================
@@ -15,6 +26,12 @@ int main(void)
 {
     SystemInit();             // Initialize system clock
     SystemCoreClockUpdate();  // Update system core clock variable
+    flash_init();             // Flash wait states for this CCLK
+
+    // Cycle counter for the ISR timing statistics
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
 
     pwm_init();               // Initialize and start PWM
 
@@ -57,12 +74,26 @@ void pwm_init(void)
     return;
 }
 
+// =========================================
+// FUNCTION: Flash accelerator wait states
+// =========================================
+void flash_init(void)
+{
+    // FLASHTIM = CPU clocks per flash access - 1: one more per 20 MHz
+    uint32_t t = (SystemCoreClock - 1) / 20000000;
+    if(t > 4) t = 4;
+    LPC_SC->FLASHCFG = (LPC_SC->FLASHCFG & 0xFFF) | (t << 12);   // reserved bits written back as read
+}
+
 // =========================================
 // INTERRUPT HANDLER: PWM1_IRQHandler
 // =========================================
-void PWM1_IRQHandler(void)
+RAMFUNC void PWM1_IRQHandler(void)
 {
+    uint32_t t0 = DWT->CYCCNT, late = LPC_PWM1->TC, d;
+
     LPC_PWM1->IR = 0xFF;             // Clear all PWM interrupt flags
+    if(late > isr_latency_max) isr_latency_max = late; // TC restarted at MR0
 
     // ---- Brightness Increasing ----
     if(flag == 0x00)
@@ -91,4 +122,8 @@ void PWM1_IRQHandler(void)
             LPC_PWM1->LER = 0x000000FF;
         }
     }
+
+    d = DWT->CYCCNT - t0;            // Entry -> exit cycles
+    if(d < isr_cycles_min) isr_cycles_min = d;
+    if(d > isr_cycles_max) isr_cycles_max = d;
 }
@@ -0,0 +1,95 @@
+/* ---------- lcd_format check and timing (host) ----------
+   Builds lcd_format.h on a PC and checks it on the row formats the lab
+   programs use, on truncation, and on formats that end inside a
+   conversion ("%", "%5"), which must stop without fetching an argument.
+   Then times it against snprintf producing the same row, once with the
+   fixed-point split and once with the float %.2f the programs used.
+
+   Build : gcc -O2 -std=c99 -Wall -o format_bench Lcd/format_bench.c
+   Run   : ./format_bench     (exit code 0 = all checks passed)
+
+   Times are host nanoseconds, not Cortex-M3 cycles; ISR_BENCH.c prints
+   the DWT figures on the board.
+---------------------------------------------------------*/
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#define LCD_COLS 16
+#include "../lcd_format.h"
+
+#define REPS 1000000
+
+unsigned int failures;
+
+static void check(const char *want, const char *got, const char *what){
+    int ok = !strcmp(got, want);
+    printf("%-22s \"%s\" %s\n", what, got, ok ? "ok" : "FAIL");
+    if(!ok){ printf("%-22s \"%s\"\n", "  want", want); failures++; }
+}
+
+static double now_ns(void){
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+int main(void){
+    char row[LCD_COLS + 1], ref[32];
+    volatile unsigned int sink = 0;
+    unsigned int n, v, cv;
+    double t0, t[3];
+
+    /* Rows of ADC & LCD.c, CAPTURE & LCD.c, SILENT_INTRUDER_ALERT.c */
+    lcd_format(row, "A4:%4u A5:%4u", 1234, 56);               check("A4:1234 A5:  56 ", row, "A4 / A5");
+    lcd_format(row, "%.2u-%.2u R%.2uV", 5, 330, 123);         check("0.05-3.30 R1.23V", row, "diff min / max / rms");
+    lcd_format(row, "F:%12.2uHz", 83330);                     check("F:      833.30Hz", row, "frequency");
+    lcd_format(row, "dF%5dppm D%4.1d", 33, 0);                check("dF   33ppm D 0.0", row, "errors");
+    lcd_format(row, "dF%5dppm D%4.1d", -9999, -99);           check("dF-9999ppm D-9.9", row, "errors, clamped");
+    lcd_format(row, "D%4.1u%% W%7.2uu", 250, 30000);          check("D25.0% W 300.00u", row, "duty / width");
+    lcd_format(row, "Val:%4u  %.2uV", 3908, 315);             check("Val:3908  3.15V ", row, "level");
+    lcd_format(row, "INTRUDER ZONE %u", 5);                   check("INTRUDER ZONE 5 ", row, "zone");
+    lcd_format(row, "%x %5x", 0xBEEFu, 0x2Au);                check("BEEF    2A      ", row, "hex");
+
+    /* Bounded: width and text beyond LCD_COLS are cut */
+    lcd_format(row, "%20u", 7u);                               check("                ", row, "width > row");
+    lcd_format(row, "Silent Intruder Alert");                 check("Silent Intruder ", row, "text > row");
+
+    /* Format ends inside a conversion: stop, take no argument */
+    lcd_format(row, "%u%", 7u, 99u);                           check("7               ", row, "trailing %");
+    lcd_format(row, "X%5", 42u);                               check("X               ", row, "trailing %5");
+    lcd_format(row, "X%.2", 42u);                              check("X               ", row, "trailing %.2");
+    lcd_format(row, "100%%");                                  check("100%            ", row, "%%");
+
+    /* Timing: the level row of SILENT_INTRUDER_ALERT.c */
+    t0 = now_ns();
+    for(n = 0; n < REPS; n++){
+        v = 3000 + (n & 1023);
+        lcd_format(row, "Val:%4u  %.2uV", v, (v * 330 + 2047) / 4095);
+        sink += row[5];
+    }
+    t[0] = now_ns() - t0;
+
+    t0 = now_ns();
+    for(n = 0; n < REPS; n++){
+        v = 3000 + (n & 1023);
+        cv = (v * 330 + 2047) / 4095;
+        snprintf(ref, sizeof ref, "Val:%4u  %u.%02uV ", v, cv / 100, cv % 100);
+        sink += ref[5];
+    }
+    t[1] = now_ns() - t0;
+
+    t0 = now_ns();
+    for(n = 0; n < REPS; n++){
+        v = 3000 + (n & 1023);
+        snprintf(ref, sizeof ref, "Val:%4u  %.2fV ", v, v * 3.3f / 4095);
+        sink += ref[5];
+    }
+    t[2] = now_ns() - t0;
+
+    printf("ns per row: lcd_format %.1f, snprintf fixed-point %.1f, snprintf %%.2f %.1f\n",
+           t[0] / REPS, t[1] / REPS, t[2] / REPS);
+    (void)sink;
+    return failures ? 1 : 0;
+}
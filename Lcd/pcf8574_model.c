@@ -0,0 +1,221 @@
+/* ---------- PCF8574 + HD44780 model (host) ----------
+   Builds the I2C LCD transport from lcd_i2c.h against fake I2C2 registers
+   and plays the I2C bus itself: START / SLA+W / data / STOP states go to
+   I2C2_IRQHandler exactly as the peripheral would report them, every data
+   byte lands on an emulated PCF8574, and its P0..P7 pins drive an HD44780
+   model (8-bit power-on state, 4-bit switch, DDRAM, busy time).
+
+   Build : gcc -O2 -std=c99 -Wall -o lcd_model Lcd/pcf8574_model.c
+   Run   : ./lcd_model        (exit code 0 = all checks passed)
+
+   Time only advances with bus bits (9 per byte, SCL period from the
+   I2SCLH / I2SCLL that i2c_set_rate() programs) and with LCD_DELAY_US().
+   An EN strobe while the HD44780 is still busy is a failure: 4.1 ms
+   after the first 8-bit function set, 100 us after the second, 37 us
+   normally, 1.52 ms for clear / home. A too short init wait or
+   LCD_SLOW_PAD shows up here.
+-----------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+/* ---------- Same settings as SILENT_INTRUDER_ALERT.c ---------- */
+#define PCF8574_ADDR      0x27
+#define I2C_RATE_HZ       400000
+#define I2C_QLEN          256
+
+/* ---------- Fake registers ---------- */
+struct { volatile uint32_t I2CONSET, I2STAT, I2DAT, I2SCLH, I2SCLL, I2CONCLR; } i2c2;
+struct { uint32_t PCONP; } sc;
+struct { uint32_t PINSEL0, PINMODE0, PINMODE_OD0; } pincon;
+#define LPC_I2C2   (&i2c2)
+#define LPC_SC     (&sc)
+#define LPC_PINCON (&pincon)
+#define I2C2_IRQn  0
+static void NVIC_EnableIRQ(int irq){ (void)irq; }
+uint32_t SystemCoreClock = 100000000;
+
+double now_us;                                  // model time
+
+static void bus_step(void);
+#define I2C_WAIT() bus_step()
+#define LCD_DELAY_US(us) (now_us += (us))
+#define ISR_STATS 0                             // no DWT here; see Sim/
+#include "../lcd_i2c.h"
+
+void lcd_string(const char *s){ while(*s) lcd_data(*s++); }
+
+/* ---------- HD44780 ---------- */
+struct {
+    uint8_t ddram[0x80];
+    uint8_t ac, mode8, lines2, display, inc, hi, haveHi, fsets8;
+    double busyUntil;
+} lcd = { .mode8 = 1 };
+
+unsigned int violations, rwHigh, strobes;
+
+static void lcd_exec(int rs, uint8_t v){
+    double busy = 37;
+
+    if(rs){
+        lcd.ddram[lcd.ac] = v;
+        busy = 41;
+        if(lcd.inc){ if(++lcd.ac == 0x28) lcd.ac = 0x40; else if(lcd.ac == 0x68) lcd.ac = 0x00; }
+        else       { if(lcd.ac-- == 0x00) lcd.ac = 0x67; else if(lcd.ac == 0x3F) lcd.ac = 0x27; }
+    }
+    else if(v == 0x01){ memset(lcd.ddram, ' ', sizeof lcd.ddram); lcd.ac = 0; lcd.inc = 1; busy = 1520; }
+    else if((v & 0xFE) == 0x02){ lcd.ac = 0; busy = 1520; }
+    else if(v < 0x08) lcd.inc = (v >> 1) & 1;
+    else if(v < 0x10) lcd.display = (v >> 2) & 1;
+    else if(v < 0x20) ;                         // cursor / display shift
+    else if(v < 0x40){
+        if(lcd.mode8 && lcd.fsets8 < 2) busy = lcd.fsets8++ ? 100 : 4100;  // power-on reset sequence
+        lcd.mode8 = (v >> 4) & 1; lcd.lines2 = (v >> 3) & 1; lcd.haveHi = 0;
+    }
+    else if(v < 0x80) ;                         // CGRAM address
+    else lcd.ac = v & 0x7F;
+    lcd.busyUntil = now_us + busy;
+}
+
+// Falling EN: HD44780 latches D4..D7 (D0..D3 are not wired on the backpack)
+static void lcd_strobe(int rs, uint8_t nibble){
+    strobes++;
+    if(now_us < lcd.busyUntil){
+        if(!violations) printf("  busy violation at %.1f us (%.1f us early)\n", now_us, lcd.busyUntil - now_us);
+        violations++;
+    }
+    if(lcd.mode8){ lcd_exec(rs, nibble << 4); return; }
+    if(!lcd.haveHi){ lcd.hi = nibble; lcd.haveHi = 1; return; }
+    lcd.haveHi = 0;
+    lcd_exec(rs, (lcd.hi << 4) | nibble);
+}
+
+/* ---------- PCF8574: P0 RS, P1 RW, P2 EN, P3 backlight, P4..P7 D4..D7 ---------- */
+uint8_t pcfOut;
+
+static void pcf_write(uint8_t b){
+    if(b & 0x02) rwHigh++;
+    if((pcfOut & 0x04) && !(b & 0x04)) lcd_strobe(b & 0x01, b >> 4);
+    pcfOut = b;
+}
+
+/* ---------- I2C2 bus + peripheral ---------- */
+enum { BUS_IDLE, BUS_ADDR, BUS_DATA } bus = BUS_IDLE;
+unsigned long idleWaits, bytes;
+
+static double scl_us(void){ return (i2c2.I2SCLH + i2c2.I2SCLL) * 1e6 / (SystemCoreClock / 4); }
+static void bus_bits(int n){ now_us += n * scl_us(); }
+
+static void bus_after_isr(void){
+    if(i2c2.I2CONSET & 0x10){                   // STOP requested
+        i2c2.I2CONSET &= ~0x10u;
+        bus_bits(1);
+        bus = BUS_IDLE;
+    }
+    else bus = BUS_DATA;
+}
+
+static void bus_step(void){
+    switch(bus){
+        case BUS_IDLE:
+            if(!(i2c2.I2CONSET & 0x20)){        // someone waits on a bus nobody started
+                if(++idleWaits > 1000000){ printf("FAIL: waiting with the bus idle\n"); exit(1); }
+                return;
+            }
+            i2c2.I2CONSET &= ~0x20u;
+            bus_bits(1);
+            i2c2.I2STAT = 0x08;
+            I2C2_IRQHandler();
+            bus = BUS_ADDR;
+            break;
+        case BUS_ADDR:
+            bus_bits(9);
+            if(i2c2.I2DAT != (PCF8574_ADDR << 1)){ printf("FAIL: SLA+W 0x%02X\n", (unsigned)i2c2.I2DAT); i2c2.I2STAT = 0x20; }
+            else i2c2.I2STAT = 0x18;
+            I2C2_IRQHandler();
+            bus_after_isr();
+            break;
+        case BUS_DATA:
+            bus_bits(9);
+            pcf_write(i2c2.I2DAT);              // outputs change after the ACK
+            bytes++;
+            i2c2.I2STAT = 0x28;
+            I2C2_IRQHandler();
+            bus_after_isr();
+            break;
+    }
+}
+
+/* ---------- Checks ---------- */
+unsigned int failures;
+
+static void check_row(uint8_t addr, const char *want){
+    char got[17];
+    memcpy(got, &lcd.ddram[addr], 16);
+    got[16] = '\0';
+    if(strncmp(got, want, 16)){ printf("  row 0x%02X: \"%s\", want \"%s\"\n", addr, got, want); failures++; }
+}
+
+static void check(const char *name, int ok){
+    printf("%-34s %s\n", name, ok ? "ok" : "FAIL");
+    if(!ok) failures++;
+}
+
+// Fast-mode SCL at a given CCLK: <= I2C_RATE_HZ, tLOW >= 1.3 us, tHIGH >= 0.6 us
+static void check_scl(uint32_t cclk){
+    char name[40];
+    double pclk, lo, hi;
+
+    SystemCoreClock = cclk;
+    i2c_set_rate();
+    pclk = cclk / 4;
+    lo = i2c2.I2SCLL * 1e6 / pclk;
+    hi = i2c2.I2SCLH * 1e6 / pclk;
+    snprintf(name, sizeof name, "SCL at %u MHz: %.0f kHz %.2f/%.2f us", (unsigned)(cclk / 1000000), 1e3 / (lo + hi), hi, lo);
+    check(name, 1e6 / (lo + hi) <= I2C_RATE_HZ && lo >= 1.3 && hi >= 0.6);
+}
+
+int main(void){
+    char row[17];
+    int k;
+
+    check_scl(20000000);                        // CLK_IDLE
+    check_scl(100000000);                       // CLK_ALARM, used below
+
+    /* Power-on: DDRAM holds garbage until the first clear */
+    memset(lcd.ddram, '?', sizeof lcd.ddram);
+
+    lcd_init();
+    i2c_flush();
+    check("init: 4-bit, 2 lines, display on", !lcd.mode8 && lcd.lines2 && lcd.display && lcd.inc);
+
+    lcd_cmd(0x80);
+    lcd_string("Silent Intruder ");
+    lcd_cmd(0xC0);
+    lcd_string("Z:oo#oooo-      ");
+    i2c_flush();
+    check_row(0x00, "Silent Intruder ");
+    check_row(0x40, "Z:oo#oooo-      ");
+    check("init + two rows: DDRAM", failures == 0);
+
+    /* > 256 queued bytes per flush: ring wrap and the queue-full wait */
+    for(k = 0; k < 12; k++){
+        lcd_cmd(0x01);
+        lcd_cmd(0x80);
+        snprintf(row, sizeof row, "row %2d clear+pad", k);
+        lcd_string(row);
+    }
+    i2c_flush();
+    check_row(0x00, "row 11 clear+pad");
+    check_row(0x40, "                ");
+    check("12 x clear + row: DDRAM", failures == 0);
+
+    check("no EN strobe while LCD busy", violations == 0);
+    check("RW never high", rwHigh == 0);
+    check("no NACK / bus error", i2cNacks == 0);
+    check("queue drained, bus idle", i2cHead == i2cTail && !i2cBusy && bus == BUS_IDLE);
+
+    printf("%lu bytes, %u strobes, %.2f ms bus time\n", bytes, strobes, now_us / 1000);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,194 @@
+/* ---------- Lock-in vs DC beam detection (host) ----------
+   Drives an LDR divider model (LDR to 3.3 V, resistor to GND, junction on
+   AD0.2) with a laser that is either steady (DC mode, 10k as in
+   Project/README.md) or chopped at LOCKIN_FMOD (lock-in mode, 330R as in
+   the SILENT_INTRUDER_ALERT.c wiring note), plus ambient light, and
+   samples it at exactly the instants the board does: MAT0.1 rising edges
+   at 1/8, 3/8, 5/8 and 7/8 of each laser period. Lock-in samples go
+   through lockin.h, the same code ADC_IRQHandler runs.
+   The LDR is a first-order lag on its conductance (~ lux^0.7).
+
+   Build : gcc -O2 -std=c99 -Wall -o lockin_sim Lockin/lockin_sim.c -lm
+   Use   : lockin_sim [-f fmod] [-c cycles] [-t threshold] [-s seed]
+
+   Each scenario runs 60 s with the beam broken for 0.6 s every 4 s.
+   Samples (DC) or windows (lock-in) within 0.15 s of a beam edge are left
+   out; everything else counts as "present" or "broken". Per detector:
+     present min / broken max : worst case on each side of the threshold
+     margin : min(present min - thr, thr - broken max), < 0 = errors
+     SNR    : (present mean - broken mean) / pooled rms spread, in dB
+     false / missed : present values below, broken values at or above thr
+----------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../lockin.h"
+
+/* ---------- Same settings as SILENT_INTRUDER_ALERT.c ---------- */
+#define LOCKIN_FMOD      25
+#define LOCKIN_CYCLES    5
+#define LOCKIN_THRESHOLD 150
+#define BEAM_THRESHOLD   3650
+
+/* ---------- Sensor model ---------- */
+#define R_DC         10000.0        // divider resistor to GND, DC mode
+#define R_LOCKIN     330.0          // divider resistor to GND, lock-in mode
+#define LDR_R10      10000.0        // LDR resistance at 10 lux (GL5528 class)
+#define LDR_GAMMA    0.7            // R ~ lux^-gamma
+#define LDR_TAU_UP   0.020          // s, response to rising light
+#define LDR_TAU_DOWN 0.030          // s, response to falling light
+#define LASER_LUX    5000.0         // laser spot on the LDR
+#define ADC_NOISE    6.0            // counts rms (board + ADC)
+#define SUBSTEPS     16             // integration steps per 1/8 period
+
+#define SIM_SECONDS  60.0
+#define BREAK_EVERY  4.0            // s between beam breaks
+#define BREAK_LEN    0.6            // s per break
+#define EDGE_GUARD   0.15           // s around beam edges left out
+#define TWO_PI       6.283185307179586
+
+typedef struct {
+    const char *name;
+    double lux;                     // steady ambient (daylight)
+    double drift;                   // slow +-fraction of lux at 0.1 Hz
+    double lamp;                    // mains lamps, lux
+    double lampEvery;               // lamps toggled every N s, 0 = always on
+    double mains, depth, depth2;    // flicker at 2 x and 4 x mains
+    double noise;                   // ADC noise, counts rms
+} scenario;
+
+static const scenario scenarios[] = {
+    { "dark room",            5,    0,    0,   0,   0,     0,    0,    ADC_NOISE },
+    { "lamps, 50 Hz mains",   5,    0,    150, 0,   50.03, 0.30, 0.10, ADC_NOISE },
+    { "lamps, 60 Hz mains",   5,    0,    150, 0,   59.97, 0.30, 0.10, ADC_NOISE },
+    { "lamps on/off, 2.5 s",  5,    0,    300, 2.5, 50.03, 0.30, 0.10, ADC_NOISE },
+    { "bright 60 Hz lamp",    5,    0,    1000, 0,  59.97, 0.50, 0.10, ADC_NOISE },
+    { "daylight, drifting",   1500, 0.20, 0,   0,   0,     0,    0,    ADC_NOISE },
+    { "50 Hz lamps, noisy",   5,    0,    150, 0,   50.03, 0.30, 0.10, 40 },
+};
+#define NSCEN (int)(sizeof(scenarios) / sizeof(scenarios[0]))
+
+typedef struct {
+    unsigned long np, nb, falseTrips, missed;
+    double pMin, pSum, pSq, bMax, bSum, bSq;
+} det_stats;
+
+static uint32_t rng;
+static double gauss(void){              // Box-Muller on xorshift32
+    double u, v;
+    rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5; u = (rng + 1.0) / 4294967297.0;
+    rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5; v = (rng + 1.0) / 4294967297.0;
+    return sqrt(-2.0 * log(u)) * cos(TWO_PI * v);
+}
+
+static double ambient(const scenario *s, double t){
+    double lux = s->lux * (1.0 + s->drift * sin(TWO_PI * 0.1 * t));
+    if(s->lamp > 0 && (s->lampEvery == 0 || (int)(t / s->lampEvery) % 2))
+        lux += s->lamp * (1.0 + s->depth  * cos(TWO_PI * 2 * s->mains * t)
+                              + s->depth2 * cos(TWO_PI * 4 * s->mains * t));
+    return lux;
+}
+
+static int beam_broken(double t){ return fmod(t, BREAK_EVERY) >= BREAK_EVERY - BREAK_LEN; }
+
+static int near_edge(double t0, double t1){     // [t0, t1] within the guard of an edge
+    double a = fmod(t0, BREAK_EVERY), b = a + (t1 - t0), e1 = BREAK_EVERY - BREAK_LEN, e2 = BREAK_EVERY;
+    return (b > e1 - EDGE_GUARD && a < e1 + EDGE_GUARD) || (b > e2 - EDGE_GUARD && a < e2 + EDGE_GUARD)
+        || a < EDGE_GUARD;
+}
+
+static double ldr_g(double lux){ return pow(lux / 10.0, LDR_GAMMA) / LDR_R10; }
+
+static void ldr_step(double *g, double lux, double dt){
+    double target = ldr_g(lux);
+    *g += (target - *g) * dt / (target > *g ? LDR_TAU_UP : LDR_TAU_DOWN);
+}
+
+static int adc_counts(double g, double rFixed, double noise){
+    double c = 4095.0 * rFixed / (rFixed + 1.0 / g) + noise * gauss();
+    return c < 0 ? 0 : c > 4095 ? 4095 : (int)lround(c);
+}
+
+static void add(det_stats *d, int broken, double v, double thr){
+    if(!broken){
+        if(!d->np || v < d->pMin) d->pMin = v;
+        d->np++; d->pSum += v; d->pSq += v * v;
+        if(v < thr) d->falseTrips++;
+    }
+    else{
+        if(!d->nb || v > d->bMax) d->bMax = v;
+        d->nb++; d->bSum += v; d->bSq += v * v;
+        if(v >= thr) d->missed++;
+    }
+}
+
+static void print_row(const char *det, const det_stats *d, double thr){
+    double pm = d->pSum / d->np, bm = d->bSum / d->nb;
+    double pv = d->pSq / d->np - pm * pm, bv = d->bSq / d->nb - bm * bm;
+    double sd = sqrt((pv > 0 ? pv : 0) / 2 + (bv > 0 ? bv : 0) / 2);
+    double margin = fmin(d->pMin - thr, thr - d->bMax);
+
+    printf("  %-8s thr %4.0f  present min %6.0f  broken max %6.0f  margin %+6.0f  SNR %5.1f dB"
+           "  false %5.1f %%  missed %5.1f %%\n",
+           det, thr, d->pMin, d->bMax, margin, 20 * log10((pm - bm) / (sd > 1e-3 ? sd : 1e-3)),
+           100.0 * d->falseTrips / d->np, 100.0 * d->missed / d->nb);
+}
+
+/* One scenario, both detectors. The DC detector sees a steady laser, the
+   lock-in detector the chopped one; both get the same ambient and noise. */
+static void run(const scenario *s, double fmod_hz, unsigned int cycles, double lockThr, uint32_t seed){
+    double tick = 1.0 / (8 * fmod_hz), dt = tick / SUBSTEPS, t = 0, winStart = 0;
+    double gDc = ldr_g(s->lux + LASER_LUX), gLock = ldr_g(s->lux + LASER_LUX / 2);
+    unsigned long k, nTicks = (unsigned long)(SIM_SECONDS / tick);
+    int j, winBroken = -1;
+    det_stats dc = { 0 }, lock = { 0 };
+    lockin_acc acc;
+
+    rng = seed;
+    lockin_reset(&acc);
+    for(k = 0; k < nTicks; k++){
+        for(j = 0; j < SUBSTEPS; j++, t += dt){
+            double amb = ambient(s, t), beam = beam_broken(t) ? 0 : LASER_LUX;
+            double chop = fmod(t * fmod_hz, 1.0) < 0.5 ? beam : 0;        // PWM1.1 high first half
+            ldr_step(&gDc, amb + beam, dt);
+            ldr_step(&gLock, amb + chop, dt);
+        }
+        if(k % 2 == 0) continue;                 // MAT0.1 rising edge on odd ticks
+
+        if(!near_edge(t, t)) add(&dc, beam_broken(t), adc_counts(gDc, R_DC, s->noise), BEAM_THRESHOLD);
+
+        if(acc.phase == 0 && acc.count == 0){ winStart = t; winBroken = beam_broken(t); }
+        if(lockin_sample(&acc, adc_counts(gLock, R_LOCKIN, s->noise), cycles)
+           && winBroken == beam_broken(t) && !near_edge(winStart, t))
+            add(&lock, winBroken, lockin_amplitude(acc.winI, acc.winQ, cycles), lockThr);
+    }
+
+    printf("%s\n", s->name);
+    print_row("DC", &dc, BEAM_THRESHOLD);
+    print_row("lock-in", &lock, lockThr);
+}
+
+int main(int argc, char **argv){
+    double fmod_hz = LOCKIN_FMOD, thr = LOCKIN_THRESHOLD;
+    unsigned int cycles = LOCKIN_CYCLES;
+    uint32_t seed = 1;
+    int i;
+
+    for(i = 1; i < argc; i++){
+        if(!strcmp(argv[i], "-f") && i + 1 < argc) fmod_hz = atof(argv[++i]);
+        else if(!strcmp(argv[i], "-c") && i + 1 < argc) cycles = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "-t") && i + 1 < argc) thr = atof(argv[++i]);
+        else if(!strcmp(argv[i], "-s") && i + 1 < argc) seed = strtoul(argv[++i], NULL, 0);
+        else{
+            fprintf(stderr, "usage: lockin_sim [-f fmod] [-c cycles] [-t threshold] [-s seed]\n");
+            return 2;
+        }
+    }
+    if(fmod_hz <= 0 || cycles == 0 || cycles > 255){ fprintf(stderr, "bad -f / -c\n"); return 2; }
+
+    printf("lock-in %.1f Hz, %u periods (%.0f ms) per window, LDR tau %.0f/%.0f ms\n\n",
+           fmod_hz, cycles, 1000.0 * cycles / fmod_hz, LDR_TAU_UP * 1000, LDR_TAU_DOWN * 1000);
+    for(i = 0; i < NSCEN; i++) run(&scenarios[i], fmod_hz, cycles, thr, seed ? seed : 1);
+    return 0;
+}
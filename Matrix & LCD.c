@@ -1,10 +1,21 @@
 #include <LPC17xx.h>
+#include <stdint.h>
 
 // ---------------- LCD Pin Definitions ----------------
 #define RS_CTRL  0x08000000   // P0.27
 #define EN_CTRL  0x10000000   // P0.28
 #define DT_CTRL  0x07800000   // P0.23–P0.26 (Data lines)
 
+// ---------------- Bit-band Access ----------------
+// GPIO sits in the Cortex-M3 SRAM bit-band region (0x2000_0000–0x200F_FFFF),
+// so each port bit has its own word alias: one store toggles exactly one pin.
+#ifndef BITBAND_SRAM
+#define BITBAND_SRAM(addr, bit) \
+    (*(volatile uint32_t *)(0x22000000UL + \
+        (((uint32_t)(addr) - 0x20000000UL) << 5) + ((bit) << 2)))
+#endif
+#define LCD_EN_BB  BITBAND_SRAM(&LPC_GPIO0->FIOPIN, 28)   // P0.28 alias
+
 // ---------------- Global Variables ----------------
 unsigned long int temp1, temp2, i;
 unsigned char flag1 = 0, flag2 = 0;
@@ -129,16 +140,14 @@ void lcd_write(void)
 // =====================================================
 void port_write(void)
 {
-    LPC_GPIO0->FIOPIN = temp2;
-
-    if (flag1 == 0)
-        LPC_GPIO0->FIOCLR = RS_CTRL; // Command mode
-    else
-        LPC_GPIO0->FIOSET = RS_CTRL; // Data mode
+    // FIOCLR / FIOSET only touch the pins named, so the keypad rows keep
+    // their state: zeros of nibble + RS, then ones + EN = 1 in one store
+    uint32_t v = temp2 | ((flag1 == 0) ? 0 : RS_CTRL);
 
-    LPC_GPIO0->FIOSET = EN_CTRL;     // EN = 1
+    LPC_GPIO0->FIOCLR = (DT_CTRL | RS_CTRL) & ~v;
+    LPC_GPIO0->FIOSET = v | EN_CTRL;
     delay_lcd(25);
-    LPC_GPIO0->FIOCLR = EN_CTRL;     // EN = 0
+    LCD_EN_BB = 0;                   // EN = 0, LCD latches the nibble
     delay_lcd(30000);
 }
 
@@ -1,11 +1,20 @@
 ```c
 #include "LPC17xx.h"
+#include <stdint.h>
 
 // LCD Control Pins
 #define RS_CTRL 0x08000000 // P0.27, 1<<27
 #define EN_CTRL 0x10000000 // P0.28, 1<<28
 #define DT_CTRL 0x07800000 // P0.23 to P0.26 data lines, F<<23
 
+// Bit-band alias of a GPIO bit (GPIO lives in the SRAM bit-band region)
+#ifndef BITBAND_SRAM
+#define BITBAND_SRAM(addr, bit) \
+    (*(volatile uint32_t *)(0x22000000UL + \
+        (((uint32_t)(addr) - 0x20000000UL) << 5) + ((bit) << 2)))
+#endif
+#define LCD_EN_BB BITBAND_SRAM(&LPC_GPIO0->FIOPIN, 28) // P0.28 alias
+
 // Buzzer Pin
 #define BUZZER_PIN (1 << 17) // P0.17
 
@@ -13,18 +22,42 @@
 #define PIR_PIN (1 << 10) // P0.10
 
 // Motion detection settings
-#define MOTION_PERSISTENCE 50 // Number of cycles to maintain "motion detected" state
+#define MOTION_PERSISTENCE 1000 // ms without motion before "motion detected" clears
+
+// Fast boot: PIR detection runs in the 1 ms SysTick interrupt and is armed
+// before the LCD is touched. The LCD is brought up from the main loop one
+// command at a time, each after its own HD44780 wait, so it never delays
+// detection.
+#define LCD_POWER_ON_MS 15 // HD44780 wait after VCC rises
+
+// Boot time. P0.11 is pulled up from reset and driven low once detection
+// is armed: on a scope, nRESET rising -> P0.11 falling is the full boot
+// (boot ROM, startup code, SystemInit() and our own setup).
+// The LCD shows the part the firmware can time itself: main() entry ->
+// armed, counted by the watchdog timer. It runs from the 4 MHz IRC
+// (WDCLK/4 = 1 us per tick, +-1 %), not from the PLL, so the clock
+// switches inside SystemInit() don't affect it. WDRESET is never set:
+// the WDT only counts, and a timeout (71 min) just sets WDTOF.
+#define BOOT_MARK_PIN (1 << 11) // P0.11, low = armed
 
 // Global variables
-unsigned long int temp1 = 0, temp2 = 0, i, j;
+unsigned long int temp1 = 0, temp2 = 0, i;
 unsigned char flag1 = 0, flag2 = 0;
 unsigned char motion_msg[] = {"Motion Detected!"};
 unsigned char no_motion_msg[] = {"Monitoring..."};
-int motion_state;
-int no_motion_counter = 0;
+volatile int motion_state;
+volatile int no_motion_counter = 0;
+volatile uint32_t ms_ticks = 0;
 
-// LCD initialization commands
+// main() entry -> armed in us (WDT ticks), reported on the LCD
+uint32_t main_armed_us;
+
+// LCD initialization commands and the wait (ms) after each one
 unsigned long int init_command[] = {0x30, 0x30, 0x30, 0x20, 0x28, 0x0c, 0x06, 0x01, 0x80};
+unsigned char init_wait_ms[]     = {5,    1,    1,    1,    1,    1,    1,    2,    1};
+unsigned int lcd_step = 0;
+uint32_t lcd_due = LCD_POWER_ON_MS;
+unsigned char lcd_ready = 0;
 
 // Function prototypes
 void lcd_write(void);
@@ -36,76 +69,105 @@ void lcd_command(unsigned long int);
 void buzzer_init(void);
 void buzzer_on(void);
 void buzzer_off(void);
+void lcd_boot_step(void);
+void lcd_put_number(uint32_t);
+void boot_timer_start(void);
 
 int main(void) {
+    int shown = -1;
+   
+    // Boot clock first: it must not depend on the PLL set up below
+    boot_timer_start();
+   
     // Initialize system
     SystemInit();
     SystemCoreClockUpdate();
    
-    // Configure GPIO pins for LCD
-    LPC_GPIO0->FIODIR = DT_CTRL | RS_CTRL | EN_CTRL;
-   
-    // Initialize buzzer
+    // Sensors and alarm output first
     buzzer_init();
    
     // Configure P0.10 as input for PIR sensor
     LPC_PINCON->PINSEL0 &= ~(3 << 20); // Clear bits 20-21 to use P0.10 as GPIO
     LPC_GPIO0->FIODIR &= ~PIR_PIN; // Set P0.10 as input
    
-    // Initialize LCD
-    flag1 = 0;
-    for (i = 0; i < 9; i++) {
-        temp1 = init_command[i];
-        lcd_write();
-    }
+    motion_state = 0;
+    no_motion_counter = 0;
    
-    // Display initial message
-    lcd_clear();
-    lcd_puts(no_motion_msg);
+    // Arm detection: SysTick samples the PIR every 1 ms from here on
+    SysTick_Config(SystemCoreClock / 1000);
+    main_armed_us = LPC_WDT->WDTC - LPC_WDT->WDTV;
+    LPC_GPIO0->FIOCLR = BOOT_MARK_PIN;
+    LPC_GPIO0->FIODIR |= BOOT_MARK_PIN; // boot marker low
    
-    motion_state = 0; // Track motion state to avoid repeated messages
-    no_motion_counter = 0;
+    // Configure GPIO pins for LCD (initialised in the background below)
+    LPC_GPIO0->FIODIR |= DT_CTRL | RS_CTRL | EN_CTRL;
    
     while(1) {
-        // Check PIR sensor state
-        if(LPC_GPIO0->FIOPIN & PIR_PIN) {
-            // Motion detected
-            no_motion_counter = 0; // Reset the no-motion counter
-           
-            if(motion_state == 0) {
-                lcd_clear();
-                lcd_puts(motion_msg);
-               
-                // Turn ON buzzer
-                buzzer_on();
-               
-                motion_state = 1;
-            }
-        } else {
-            // No motion detected in this read
-            if(motion_state == 1) {
-                // Increment the counter of consecutive no-motion readings
-                no_motion_counter++;
-               
-                // Only change state if we've had enough consecutive no-motion readings
-                if(no_motion_counter >= MOTION_PERSISTENCE) {
-                    lcd_clear();
-                    lcd_puts(no_motion_msg);
-                   
-                    // Turn OFF buzzer
-                    buzzer_off();
-                   
-                    motion_state = 0;
-                    no_motion_counter = 0;
-                }
+        if(!lcd_ready) {
+            lcd_boot_step();
+            continue;
+        }
+       
+        // The LCD just mirrors the state kept by SysTick_Handler
+        if(motion_state != shown) {
+            shown = motion_state;
+            lcd_clear();
+            lcd_puts(shown ? motion_msg : no_motion_msg);
+            if(!shown) {
+                lcd_command(0xC0);
+                lcd_puts((unsigned char *)"main>arm ");
+                lcd_put_number(main_armed_us);
+                lcd_puts((unsigned char *)"us");
             }
         }
        
-        // Add a small delay to debounce and reduce CPU usage
-        for(j = 0; j < 500000; j++); // Reduced delay for more responsive sensing
+        __WFI(); // Sleep until the next tick
+    }
+}
+
+// 1 ms tick: PIR sampling and alarm decision (never waits on the LCD)
+void SysTick_Handler(void) {
+    ms_ticks++;
+   
+    if(LPC_GPIO0->FIOPIN & PIR_PIN) {
+        no_motion_counter = 0;
+        if(motion_state == 0) {
+            buzzer_on();
+            motion_state = 1;
+        }
+    } else if(motion_state == 1) {
+        // Only clear after MOTION_PERSISTENCE ms of continuous no-motion
+        if(++no_motion_counter >= MOTION_PERSISTENCE) {
+            buzzer_off();
+            motion_state = 0;
+            no_motion_counter = 0;
+        }
     }
 }
 
+// Send the next LCD init command once its predecessor's wait has elapsed
+void lcd_boot_step(void) {
+    if((int32_t)(ms_ticks - lcd_due) < 0)
+        return;
+   
+    flag1 = 0;
+    temp1 = init_command[lcd_step];
+    lcd_write();
+    lcd_due = ms_ticks + init_wait_ms[lcd_step];
+   
+    if(++lcd_step == sizeof(init_command) / sizeof(init_command[0]))
+        lcd_ready = 1;
+}
+
+// Watchdog as a free-running 1 MHz down-counter on the IRC
+void boot_timer_start(void) {
+    LPC_WDT->WDCLKSEL = 0;          // IRC (reset default)
+    LPC_WDT->WDTC = 0xFFFFFFFF;
+    LPC_WDT->WDMOD = 0x01;          // WDEN only: count, never reset
+    LPC_WDT->WDFEED = 0xAA;         // feed sequence loads WDTC and starts it
+    LPC_WDT->WDFEED = 0x55;
+}
+
 // Function to initialize buzzer on P0.17
 void buzzer_init(void) {
     // Configure P0.17 as GPIO output
@@ -141,17 +203,17 @@ void lcd_write(void) {
 }
 
 // Function to write to LCD port
+// FIOCLR / FIOSET only touch the pins named, so the buzzer (P0.17) and
+// PIR input keep their state and no FIOMASK window is needed: clear the
+// zeros of nibble + RS, then set the ones together with EN. EN falls
+// through its bit-band alias.
 void port_write(void) {
-    LPC_GPIO0->FIOPIN = temp2;
-   
-    if (flag1 == 0)
-        LPC_GPIO0->FIOCLR = RS_CTRL;
-    else
-        LPC_GPIO0->FIOSET = RS_CTRL;
-   
-    LPC_GPIO0->FIOSET = EN_CTRL;
+    uint32_t v = temp2 | ((flag1 == 0) ? 0 : RS_CTRL);
+
+    LPC_GPIO0->FIOCLR = (DT_CTRL | RS_CTRL) & ~v;
+    LPC_GPIO0->FIOSET = v | EN_CTRL;
     delay_lcd(25);
-    LPC_GPIO0->FIOCLR = EN_CTRL;
+    LCD_EN_BB = 0;
     delay_lcd(30000);
 }
 
@@ -166,6 +228,18 @@ void lcd_puts(unsigned char *string) {
     }
 }
 
+// Function to display an unsigned number on LCD
+void lcd_put_number(uint32_t n) {
+    unsigned char digits[11];
+    int k = 10;
+    digits[k] = '\0';
+    do {
+        digits[--k] = '0' + (n % 10);
+        n /= 10;
+    } while(n);
+    lcd_puts(&digits[k]);
+}
+
 // Function to clear LCD screen
 void lcd_clear(void) {
     flag1 = 0; // Set to command mode
@@ -0,0 +1,63 @@
+#ifndef FREERTOS_CONFIG_H
+#define FREERTOS_CONFIG_H
+
+/* ---------- FreeRTOS configuration for the LPC1768 alarm build ----------
+   Static allocation only (no heap), tickless idle, run-time stats from
+   TIMER1 running at 1 MHz.
+--------------------------------------------------------------------------*/
+
+#include <LPC17xx.h>
+
+#define configCPU_CLOCK_HZ                      ( SystemCoreClock )
+#define configTICK_RATE_HZ                      ( 1000 )
+#define configUSE_PREEMPTION                    1
+#define configUSE_TIME_SLICING                  0
+#define configUSE_TICKLESS_IDLE                 1
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP   2
+#define configMAX_PRIORITIES                    5
+#define configMINIMAL_STACK_SIZE                ( 96 )
+#define configMAX_TASK_NAME_LEN                 8
+#define configUSE_16_BIT_TICKS                  0
+#define configIDLE_SHOULD_YIELD                 1
+#define configUSE_MUTEXES                       0
+#define configQUEUE_REGISTRY_SIZE               0
+#define configUSE_IDLE_HOOK                     0
+#define configUSE_TICK_HOOK                     0
+#define configCHECK_FOR_STACK_OVERFLOW          2
+
+/* ---------- Memory: everything is allocated statically ---------- */
+#define configSUPPORT_STATIC_ALLOCATION         1
+#define configSUPPORT_DYNAMIC_ALLOCATION        0
+#define configUSE_TIMERS                        0
+
+/* ---------- Statistics ---------- */
+#define configUSE_TRACE_FACILITY                1
+#define configGENERATE_RUN_TIME_STATS           1
+extern void vConfigureRunTimeCounter(void);
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() vConfigureRunTimeCounter()
+#define portGET_RUN_TIME_COUNTER_VALUE()        ( LPC_TIM1->TC )
+
+/* ---------- API functions pulled in ---------- */
+#define INCLUDE_vTaskDelay                      1
+#define INCLUDE_vTaskDelayUntil                 1
+#define INCLUDE_xTaskGetTickCount               1
+#define INCLUDE_uxTaskGetStackHighWaterMark     1
+#define INCLUDE_vTaskSuspend                    1
+
+/* ---------- Cortex-M3 interrupt priorities (LPC17xx: 5 bits) ---------- */
+#define configPRIO_BITS                         5
+#define configLIBRARY_LOWEST_INTERRUPT_PRIORITY         31
+#define configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY    5
+#define configKERNEL_INTERRUPT_PRIORITY \
+    ( configLIBRARY_LOWEST_INTERRUPT_PRIORITY << ( 8 - configPRIO_BITS ) )
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY \
+    ( configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY << ( 8 - configPRIO_BITS ) )
+
+#define configASSERT( x ) if( ( x ) == 0 ) { taskDISABLE_INTERRUPTS(); for( ;; ); }
+
+/* ---------- Map port handlers onto the CMSIS vector names ---------- */
+#define vPortSVCHandler     SVC_Handler
+#define xPortPendSVHandler  PendSV_Handler
+#define xPortSysTickHandler SysTick_Handler
+
+#endif /* FREERTOS_CONFIG_H */
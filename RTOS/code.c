@@ -0,0 +1,414 @@
+#include <LPC17xx.h>
+#include <stdint.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+/* ---------- Combined security firmware on FreeRTOS ----------
+   Tasks (highest priority first):
+     Detect  (4) : evaluates every sample, drives the buzzer directly
+     Sample  (3) : LDR beam (AD0.2) + PIR every SAMPLE_PERIOD_MS
+     Keypad  (2) : 4x4 keypad scan, 'A' acknowledges the alarm
+     Display (1) : LCD updates, only ever blocks itself
+     Telem   (1) : UART0 report of latency, stack and CPU usage
+   Worst-case detection latency is one sample period plus the Detect
+   task's own run time: nothing below priority 3 can delay it.
+---------------------------------------------------------------*/
+
+/* ---------- LCD on CNA ----------
+   D4–D7 : P0.4–P0.7
+   RS    : P0.8
+   EN    : P0.9
+----------------------------------*/
+#define LCD_DATA (0x0F << 4)
+#define LCD_RS   (1 << 8)
+#define LCD_EN   (1 << 9)
+
+#define BUZZER_PIN (1 << 11)        // P0.11
+#define PIR_PIN    (1 << 10)        // P0.10
+#define RESET_SW   (1 << 12)        // P2.12 = SW1, active LOW
+#define ROW_MASK   (0x0F << 15)     // Keypad rows P0.15–P0.18
+#define COL_SHIFT  19               // Keypad cols P0.19–P0.22
+
+/* ---------- Detection settings ---------- */
+#define SAMPLE_PERIOD_MS   10
+#define BEAM_THRESHOLD     3650     // ADC counts, below = beam broken
+#define MOTION_PERSISTENCE 50       // samples of no motion before clearing
+#define TELEM_PERIOD_MS    1000
+
+/* ---------- Stack sizes (words) ---------- */
+#define STACK_SAMPLE  128
+#define STACK_DETECT  128
+#define STACK_DISPLAY 160
+#define STACK_KEYPAD  128
+#define STACK_TELEM   192
+#define NUM_TASKS     5
+
+/* ---------- Messages between tasks ---------- */
+typedef struct {
+    uint32_t t_us;                  // TIMER1 timestamp of the sample
+    uint16_t adc;                   // LDR level
+    uint8_t  pir;                   // PIR output level
+} Sample_t;
+
+enum { EV_SAFE, EV_BEAM, EV_MOTION, EV_ACK, EV_KEY };
+
+typedef struct {
+    uint8_t  type;
+    uint8_t  key;
+    uint16_t adc;
+} Event_t;
+
+#define SAMPLE_QLEN  8
+#define EVENT_QLEN   8
+#define CMD_QLEN     4
+
+/* ---------- Static kernel objects ---------- */
+static StaticTask_t tcbSample, tcbDetect, tcbDisplay, tcbKeypad, tcbTelem;
+static StackType_t  stkSample[STACK_SAMPLE], stkDetect[STACK_DETECT];
+static StackType_t  stkDisplay[STACK_DISPLAY], stkKeypad[STACK_KEYPAD];
+static StackType_t  stkTelem[STACK_TELEM];
+
+static StaticQueue_t qbSample, qbDisplay, qbTelem, qbCmd;
+static uint8_t qsSample[SAMPLE_QLEN * sizeof(Sample_t)];
+static uint8_t qsDisplay[EVENT_QLEN * sizeof(Event_t)];
+static uint8_t qsTelem[EVENT_QLEN * sizeof(Event_t)];
+static uint8_t qsCmd[CMD_QLEN * sizeof(uint8_t)];
+
+static QueueHandle_t xSampleQ, xDisplayQ, xTelemQ, xCmdQ;
+static TaskHandle_t  xTasks[NUM_TASKS];
+
+/* ---------- Shared statistics ---------- */
+volatile uint32_t latency_max_us = 0;   // sample timestamp → buzzer on
+volatile uint32_t samples_dropped = 0;
+volatile uint8_t  alarm_state = 0;      // 0 = safe, 1 = beam, 2 = motion
+
+/* ---------- Free-running 1 MHz timestamp (TIMER1) ---------- */
+void vConfigureRunTimeCounter(void){
+    LPC_SC->PCONP |= (1 << 2);                       // Power TIMER1
+    LPC_TIM1->TCR = 0x02;
+    LPC_TIM1->PR  = (SystemCoreClock / 4) / 1000000 - 1;  // PCLK = CCLK/4
+    LPC_TIM1->TCR = 0x01;
+}
+
+static uint32_t now_us(void){ return LPC_TIM1->TC; }
+
+/* ---------- Small integer formatter (no printf in any task) ---------- */
+static char *put_u(char *p, uint32_t v){
+    char tmp[10]; int n = 0;
+    do { tmp[n++] = '0' + (v % 10); v /= 10; } while(v);
+    while(n) *p++ = tmp[--n];
+    return p;
+}
+
+static char *put_s(char *p, const char *s){ while(*s) *p++ = *s++; return p; }
+
+/* ---------- Hardware: buzzer, PIR, ADC, switch ---------- */
+static void buzzer_on(void){ LPC_GPIO0->FIOSET = BUZZER_PIN; }
+static void buzzer_off(void){ LPC_GPIO0->FIOCLR = BUZZER_PIN; }
+
+static void io_init(void){
+    LPC_GPIO0->FIODIR |= BUZZER_PIN;
+    buzzer_off();
+    LPC_PINCON->PINSEL0 &= ~(3 << 20);               // P0.10 GPIO (PIR)
+    LPC_GPIO0->FIODIR &= ~PIR_PIN;
+    LPC_PINCON->PINSEL4 &= ~(3 << 24);               // P2.12 GPIO (SW1)
+    LPC_GPIO2->FIODIR &= ~RESET_SW;
+
+    LPC_SC->PCONP |= (1 << 12);                      // Power ADC
+    LPC_PINCON->PINSEL1 &= ~(3 << 18);
+    LPC_PINCON->PINSEL1 |=  (1 << 18);               // P0.25 as AD0.2
+    LPC_ADC->ADCR = (1 << 2) | (4 << 8) | (1 << 21); // channel 2, clkdiv, PDN
+
+    LPC_GPIO0->FIODIR |= ROW_MASK;                   // Keypad rows out
+    LPC_GPIO0->FIODIR &= ~(0x0F << COL_SHIFT);       // Keypad cols in
+    LPC_PINCON->PINMODE1 &= ~(0xFF << 6);            // Pull-ups on cols
+}
+
+static uint16_t read_adc(void){
+    uint32_t r;
+    LPC_ADC->ADCR |= (1 << 24);                      // Start conversion
+    while(!((r = LPC_ADC->ADGDR) & (1UL << 31)));    // 65 clocks at 5 MHz, ~13 us
+    LPC_ADC->ADCR &= ~(7 << 24);
+    return (r >> 4) & 0xFFF;
+}
+
+/* ---------- UART0 telemetry (P0.2 TXD0), 115200 8N1 ---------- */
+static void uart_init(void){
+    uint32_t div = (SystemCoreClock / 4) / (16 * 115200);
+    LPC_PINCON->PINSEL0 &= ~(3 << 4);
+    LPC_PINCON->PINSEL0 |=  (1 << 4);                // P0.2 as TXD0
+    LPC_UART0->LCR = 0x83;                           // 8N1, DLAB = 1
+    LPC_UART0->DLL = div & 0xFF;
+    LPC_UART0->DLM = div >> 8;
+    LPC_UART0->LCR = 0x03;                           // DLAB = 0
+    LPC_UART0->FCR = 0x07;                           // Enable + reset FIFOs
+}
+
+// Fills the 16-byte TX FIFO and sleeps while it drains (never spins)
+static void uart_write(const char *s, uint32_t len){
+    while(len){
+        uint32_t n = 16;
+        while(!(LPC_UART0->LSR & (1 << 5))) vTaskDelay(1);   // THRE
+        while(n-- && len){ LPC_UART0->THR = *s++; len--; }
+    }
+}
+
+/* ---------- LCD (only touched by the Display task) ---------- */
+static void lcd_spin(volatile uint32_t d){ while(d--); }
+
+static void lcd_write_nibble(uint8_t nibble){
+    LPC_GPIO0->FIOCLR = LCD_DATA;
+    LPC_GPIO0->FIOSET = ((nibble & 0x0F) << 4);
+    LPC_GPIO0->FIOSET = LCD_EN; lcd_spin(100);
+    LPC_GPIO0->FIOCLR = LCD_EN; lcd_spin(1000);      // > 37 us execution
+}
+
+static void lcd_write_byte(uint8_t val, int is_data){
+    if(is_data) LPC_GPIO0->FIOSET = LCD_RS;
+    else        LPC_GPIO0->FIOCLR = LCD_RS;
+    lcd_write_nibble(val >> 4);
+    lcd_write_nibble(val & 0x0F);
+}
+
+static void lcd_cmd(uint8_t c){
+    lcd_write_byte(c, 0);
+    if(c <= 0x03) vTaskDelay(pdMS_TO_TICKS(2) + 1);  // Clear / home: 1.52 ms, >= 2 full ticks
+}
+
+static void lcd_line(uint8_t addr, const char *s){
+    int n = 0;
+    lcd_cmd(addr);
+    while(*s && n < 16){ lcd_write_byte(*s++, 1); n++; }
+    while(n++ < 16) lcd_write_byte(' ', 1);          // Overwrite old text
+}
+
+static void lcd_init(void){
+    LPC_GPIO0->FIODIR |= LCD_DATA | LCD_RS | LCD_EN;
+    vTaskDelay(20);                                  // Power-on wait
+    lcd_cmd(0x33);
+    lcd_cmd(0x32);
+    lcd_cmd(0x28);   // 4-bit, 2-line
+    lcd_cmd(0x0C);   // Display ON, Cursor OFF
+    lcd_cmd(0x06);   // Entry mode
+    lcd_cmd(0x01);   // Clear
+}
+
+/* ---------- Task: Sample ---------- */
+static void vSampleTask(void *arg){
+    TickType_t last = xTaskGetTickCount();
+    Sample_t s;
+    (void)arg;
+
+    for(;;){
+        vTaskDelayUntil(&last, pdMS_TO_TICKS(SAMPLE_PERIOD_MS));
+        s.t_us = now_us();
+        s.adc  = read_adc();
+        s.pir  = (LPC_GPIO0->FIOPIN & PIR_PIN) ? 1 : 0;
+        if(xQueueSend(xSampleQ, &s, 0) != pdPASS) samples_dropped++;
+    }
+}
+
+/* ---------- Task: Detect ---------- */
+static void post_event(uint8_t type, uint16_t adc){
+    Event_t e;
+    e.type = type; e.key = 0; e.adc = adc;
+    xQueueSend(xDisplayQ, &e, 0);                    // Never block detection
+    xQueueSend(xTelemQ, &e, 0);
+}
+
+static void vDetectTask(void *arg){
+    Sample_t s;
+    uint8_t cmd;
+    uint32_t lat, quiet = 0;
+    (void)arg;
+
+    for(;;){
+        xQueueReceive(xSampleQ, &s, portMAX_DELAY);
+
+        if(alarm_state == 0 && (s.adc < BEAM_THRESHOLD || s.pir)){
+            buzzer_on();
+            lat = now_us() - s.t_us;
+            if(lat > latency_max_us) latency_max_us = lat;
+            alarm_state = s.pir ? 2 : 1;
+            quiet = 0;
+            post_event(s.pir ? EV_MOTION : EV_BEAM, s.adc);
+        }
+
+        /* Beam alarms latch until acknowledged; motion clears on its own */
+        if(alarm_state == 2){
+            quiet = s.pir ? 0 : quiet + 1;
+            if(quiet >= MOTION_PERSISTENCE){
+                buzzer_off();
+                alarm_state = 0;
+                post_event(EV_SAFE, s.adc);
+            }
+        }
+
+        if(xQueueReceive(xCmdQ, &cmd, 0) == pdPASS && alarm_state != 0){
+            buzzer_off();
+            alarm_state = 0;
+            post_event(EV_ACK, s.adc);
+        }
+    }
+}
+
+/* ---------- Task: Keypad ---------- */
+static char key_scan(void){
+    static const char keypad[4][4] = {
+        {'0','1','2','3'},
+        {'4','5','6','7'},
+        {'8','9','A','B'},
+        {'C','D','E','F'}
+    };
+    uint32_t row, col;
+
+    for(row = 0; row < 4; row++){
+        LPC_GPIO0->FIOSET = ROW_MASK;
+        LPC_GPIO0->FIOCLR = (1 << (15 + row));
+        lcd_spin(200);                               // Let the row settle
+        col = (LPC_GPIO0->FIOPIN >> COL_SHIFT) & 0x0F;
+        if(col != 0x0F){
+            if(!(col & 0x01)) return keypad[row][0];
+            if(!(col & 0x02)) return keypad[row][1];
+            if(!(col & 0x04)) return keypad[row][2];
+            if(!(col & 0x08)) return keypad[row][3];
+        }
+    }
+    return 'N';
+}
+
+static void vKeypadTask(void *arg){
+    char key, last = 'N';
+    uint8_t ack = 1;
+    Event_t e;
+    (void)arg;
+
+    for(;;){
+        vTaskDelay(pdMS_TO_TICKS(20));               // Also the debounce time
+        key = key_scan();
+        if((LPC_GPIO2->FIOPIN & RESET_SW) == 0) key = 'A';   // SW1 = ack
+        if(key != last && key != 'N'){
+            if(key == 'A') xQueueSend(xCmdQ, &ack, 0);
+            e.type = EV_KEY; e.key = key; e.adc = 0;
+            xQueueSend(xDisplayQ, &e, 0);
+        }
+        last = key;
+    }
+}
+
+/* ---------- Task: Display ---------- */
+static void vDisplayTask(void *arg){
+    Event_t e;
+    char line[17], *p;
+    (void)arg;
+
+    lcd_init();
+    lcd_line(0x80, "Silent Intruder");
+    lcd_line(0xC0, "ARMED");
+
+    for(;;){
+        xQueueReceive(xDisplayQ, &e, portMAX_DELAY);
+        switch(e.type){
+        case EV_BEAM:
+            lcd_line(0x80, "INTRUDER ALERT!!");
+            p = put_s(line, "Beam ADC:"); p = put_u(p, e.adc); *p = 0;
+            lcd_line(0xC0, line);
+            break;
+        case EV_MOTION:
+            lcd_line(0x80, "Motion Detected!");
+            lcd_line(0xC0, "Press A to ack");
+            break;
+        case EV_ACK:
+        case EV_SAFE:
+            lcd_line(0x80, "Silent Intruder");
+            lcd_line(0xC0, e.type == EV_ACK ? "SYSTEM RESET OK" : "ARMED");
+            break;
+        case EV_KEY:
+            p = put_s(line, "KEY: "); *p++ = e.key; *p = 0;
+            lcd_line(0xC0, line);
+            break;
+        }
+    }
+}
+
+/* ---------- Task: Telemetry ---------- */
+static void vTelemTask(void *arg){
+    static TaskStatus_t status[NUM_TASKS + 1];       // + idle task
+    static char buf[96];
+    uint32_t total, n, k;
+    TickType_t last = xTaskGetTickCount();
+    Event_t e;
+    char *p;
+    (void)arg;
+
+    uart_init();
+
+    for(;;){
+        vTaskDelayUntil(&last, pdMS_TO_TICKS(TELEM_PERIOD_MS));
+
+        while(xQueueReceive(xTelemQ, &e, 0) == pdPASS){
+            p = put_s(buf, "EVT "); p = put_u(p, e.type);
+            p = put_s(p, " adc="); p = put_u(p, e.adc);
+            p = put_s(p, "\r\n");
+            uart_write(buf, p - buf);
+        }
+
+        p = put_s(buf, "STAT alarm="); p = put_u(p, alarm_state);
+        p = put_s(p, " lat_max_us="); p = put_u(p, latency_max_us);
+        p = put_s(p, " dropped="); p = put_u(p, samples_dropped);
+        p = put_s(p, "\r\n");
+        uart_write(buf, p - buf);
+
+        /* Per-task CPU share (run-time counter) and stack high-water */
+        n = uxTaskGetSystemState(status, NUM_TASKS + 1, &total);
+        total /= 100;                                // percent
+        for(k = 0; k < n; k++){
+            p = put_s(buf, "TASK "); p = put_s(p, status[k].pcTaskName);
+            p = put_s(p, " cpu%=");
+            p = put_u(p, total ? status[k].ulRunTimeCounter / total : 0);
+            p = put_s(p, " stack_free=");
+            p = put_u(p, status[k].usStackHighWaterMark);
+            p = put_s(p, "\r\n");
+            uart_write(buf, p - buf);
+        }
+    }
+}
+
+/* ---------- Kernel hooks required by static allocation ---------- */
+void vApplicationGetIdleTaskMemory(StaticTask_t **tcb, StackType_t **stack,
+                                   uint32_t *size){
+    static StaticTask_t idleTcb;
+    static StackType_t  idleStack[configMINIMAL_STACK_SIZE];
+    *tcb = &idleTcb;
+    *stack = idleStack;
+    *size = configMINIMAL_STACK_SIZE;
+}
+
+void vApplicationStackOverflowHook(TaskHandle_t task, char *name){
+    (void)task; (void)name;
+    buzzer_on();                                     // Fail loud, not silent
+    for(;;);
+}
+
+/* ---------- MAIN ---------- */
+int main(void){
+    SystemInit();
+    SystemCoreClockUpdate();
+
+    io_init();                      // TIMER1 is started by the scheduler
+
+    xSampleQ  = xQueueCreateStatic(SAMPLE_QLEN, sizeof(Sample_t), qsSample, &qbSample);
+    xDisplayQ = xQueueCreateStatic(EVENT_QLEN, sizeof(Event_t), qsDisplay, &qbDisplay);
+    xTelemQ   = xQueueCreateStatic(EVENT_QLEN, sizeof(Event_t), qsTelem, &qbTelem);
+    xCmdQ     = xQueueCreateStatic(CMD_QLEN, sizeof(uint8_t), qsCmd, &qbCmd);
+
+    xTasks[0] = xTaskCreateStatic(vDetectTask, "Detect", STACK_DETECT, 0, 4, stkDetect, &tcbDetect);
+    xTasks[1] = xTaskCreateStatic(vSampleTask, "Sample", STACK_SAMPLE, 0, 3, stkSample, &tcbSample);
+    xTasks[2] = xTaskCreateStatic(vKeypadTask, "Keypad", STACK_KEYPAD, 0, 2, stkKeypad, &tcbKeypad);
+    xTasks[3] = xTaskCreateStatic(vDisplayTask, "Display", STACK_DISPLAY, 0, 1, stkDisplay, &tcbDisplay);
+    xTasks[4] = xTaskCreateStatic(vTelemTask, "Telem", STACK_TELEM, 0, 1, stkTelem, &tcbTelem);
+
+    vTaskStartScheduler();
+    for(;;);                                         // Not reached
+}
@@ -1,6 +1,9 @@
 #include <LPC17xx.h>
-#include <stdio.h>
+#include <stdint.h>
 #include <math.h>
+#include "zone_logic.h"
+#include "ramfunc.h"             // ADC ISRs run from SRAM
+#include "isr_stats.h"           // per-ISR cycle counts, also read by Sim/
 
 /* ---------- LCD on CNA ----------
    D4–D7 : P0.4–P0.7
@@ -10,23 +13,137 @@
 #define LCD_DATA (0x0F << 4)
 #define LCD_RS   (1 << 8)
 #define LCD_EN   (1 << 9)
+#define LCD_COLS 16
+
+/* ---------- LCD over I2C (PCF8574 backpack) ----------
+   LCD_TRANSPORT_I2C = 1 drives the same HD44780 through a PCF8574 on
+   I2C2 (SDA2 = P0.10, SCL2 = P0.11) at 400 kHz and frees P0.4–P0.9.
+   Backpack wiring: P0 = RS, P1 = RW, P2 = EN, P3 = backlight, P4–P7 = D4–D7.
+--------------------------------------------------------*/
+#ifndef LCD_TRANSPORT_I2C
+#define LCD_TRANSPORT_I2C 0
+#endif
+#define PCF8574_ADDR      0x27      // 7-bit address (A2..A0 high)
+#define I2C_RATE_HZ       400000
+#define I2C_QLEN          256       // byte FIFO, index wraps as uint8_t
 
 /* ---------- Buzzer pin ---------- */
 #define BUZZER_PIN (1 << 22)
 
+/* ---------- Alarm tone (DAC AOUT on P0.26) ----------
+   TONE_ENABLE = 1: buzzer_on()/buzzer_off() start/stop a looping GPDMA
+   chain that feeds wavetables (tone_tables.h, from Tone/gen_tones.c) to
+   the DAC at TONE_FS; the CPU only sets up the channel. Zone mode picks
+   the pattern per zone (zoneTone[]). AOUT shares P0.26 with AD0.3.
+--------------------------------------------------------*/
+#define TONE_ENABLE      1
+#define TONE_SIREN       0          // 625 -> 1375 -> 625 Hz sweep
+#define TONE_CHIRP       1          // 2 / 2.5 / 3 kHz blip, 5 per second
+#define TONE_MULTI       2          // two alternating two-tone chords
+#define TONE_PATTERNS    3
+
 /* ---------- Switch pin (P2.12 = SW1) ---------- */
 #define RESET_SW (1 << 12)
 
+/* ---------- Beam detection mode ----------
+   DETECT_LEVEL  : DC level on AD0.2, trips below BEAM_THRESHOLD. Steady
+                   laser, LDR to 3.3 V with 10k to GND (Project/README.md).
+   DETECT_LOCKIN : laser driven from PWM1.1 (P2.0) at LOCKIN_FMOD,
+                   AD0.2 sampled by TIMER0 MAT0.1 at 4 x LOCKIN_FMOD and
+                   demodulated in the ADC ISR (lockin.h). Only light
+                   chopped at LOCKIN_FMOD counts; lamps and daylight don't.
+   DETECT_ZONES  : up to eight beams, one per AD0.0–AD0.7, evaluated
+                   together once per BURST scan (see "Multi-zone" below).
+   Lock-in wiring: the laser module's supply switched by P2.0 through an
+   NPN/logic MOSFET (the pin can't source the laser current), and the LDR
+   divider resistor cut to ~330R: a CdS cell only half-settles in 1/8
+   period, and the low side keeps that swing in the ADC's range with the
+   beam on. Keep LOCKIN_FMOD low with a CdS LDR (tens of ms response);
+   use a photodiode/phototransistor divider for kHz modulation.
+   Mains flicker (2 x and 4 x 50/60 Hz) sits on a multiple of 5 Hz away
+   from 25 Hz, i.e. on a null of the 5-period (200 ms) window, and the
+   integer tick PCLK / (8 * 25) holds in both clock profiles. Off-nominal
+   mains leaks in gradually (a bright lamp at 61.2 Hz still leaves +120
+   counts of margin); Lockin/lockin_sim.c has the figures against the DC
+   threshold.
+-------------------------------------------*/
+#define DETECT_LEVEL     0
+#define DETECT_LOCKIN    1
+#define DETECT_ZONES     2
+#ifndef DETECT_MODE
+#define DETECT_MODE      DETECT_LEVEL
+#endif
+#define BEAM_THRESHOLD   3650       // DC mode: counts, below = beam broken
+#define LOCKIN_FMOD      25         // Hz; 2 x and 4 x mains land on window nulls
+#define LOCKIN_CYCLES    5          // modulation periods per amplitude result
+#define LOCKIN_THRESHOLD 150        // amplitude (counts), below = beam broken
+#define ZONE_MASK        0xF7       // AD0.x channels wired as zones (AD0.3 = AOUT)
+#define ZONE_TRIP_LO     3650       // counts, below = beam broken
+#define ZONE_TRIP_HI     3750       // counts, above = beam restored
+#define ZONE_TRIP_SCANS  48         // consecutive broken scans (~5 ms) to trip
+
+#if DETECT_MODE == DETECT_ZONES && TONE_ENABLE && (ZONE_MASK & 0x08)
+#error "AD0.3 and AOUT share P0.26: clear bit 3 of ZONE_MASK or TONE_ENABLE"
+#endif
+
+/* ---------- Zone trace (UART3 TX on P0.0) ----------
+   Zone mode only. Every TRACE_DECIM-th scan is sent as a binary record
+   (format in zone_logic.h) for Trace/replay on a PC. 23 bytes per record
+   at 115200 baud is ~500 records/s, so with tracing on the ADC ISR also
+   evaluates only the recorded scans, with the trip count scaled to keep
+   the ~5 ms debounce: board and replay then see the identical stream.
+   SW1 is sampled with the scan and acknowledges from the ISR.
+-----------------------------------------------------*/
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE     0
+#endif
+#define TRACE_BAUD       115200
+#define TRACE_DECIM      32         // record / evaluate every Nth scan
+#define TRACE_QLEN       256        // byte FIFO, index wraps as uint8_t
+
+/* ---------- Clock profiles ----------
+   PLL0 stays locked at the 400 MHz set up by SystemInit(); only the CPU
+   divider changes, which is glitch-free. Everything clocked from PCLK
+   (CCLK/4) is re-derived by clock_apply() after each switch.
+   Idle is 20 MHz, not lower, so PCLK (5 MHz) divides to ADC_CLK_HZ
+   exactly: the zone scan rate and the ZONE_TRIP_SCANS debounce are the
+   same in both profiles. PCLKSEL is left alone (it must not change with
+   PLL0 connected).
+   Only the core and bus clocks drop: PLL0 at 400 MHz and the main
+   oscillator keep running, so idle saves the CPU's share of the supply
+   current and no more. Measure IDD in both profiles before counting on
+   it; the next step would be running idle from the oscillator with PLL0
+   disconnected, at the cost of a PLL relock on every alarm.
+--------------------------------------*/
+#define CLK_IDLE         0          // 400 / 20 = 20 MHz while armed
+#define CLK_ALARM        1          // 400 / 4  = 100 MHz once a beam trips
+#define ADC_CLK_HZ       5000000    // PCLK / 1 idle, PCLK / 5 alarm (<= 13 MHz)
+
 /* ---------- Globals ---------- */
 unsigned int adcVal;
-float volts;
-char lcdBuffer[32];
+unsigned int centivolts;            // adcVal in 0.01 V
+unsigned int lockAmp;               // demodulated beam amplitude (counts)
+char lcd_line[LCD_COLS + 1];
 unsigned char counter = 0;
 unsigned char intruder_state = 0;   // 0 = safe, 1 = intruder
+unsigned char clockProfile = CLK_ALARM;  // SystemInit() runs at full speed
+unsigned char delayDiv = 1;         // delay() scaling for the current CCLK
 
-/* ---------- Delay ---------- */
-void delay(unsigned long d){ unsigned long x; for(x=0;x<d;x++); }
+/* ADC ISR statistics (isr_stats.h, watch in the debugger). Lock-in
+   samples are timed from the MAT0.1 edge; a BURST scan has no timestamp,
+   so zone mode records exit cycles only. */
+#if DETECT_MODE == DETECT_LOCKIN
+ISR_STATS_DEF(adcStats, "ADC lock-in");
+#elif DETECT_MODE == DETECT_ZONES
+ISR_STATS_DEF(adcStats, "ADC zones");
+#endif
 
+/* ---------- Delay (same wall time in every clock profile) ---------- */
+void delay(unsigned long d){ unsigned long x; d /= delayDiv; for(x=0;x<d;x++); }
+
+#if LCD_TRANSPORT_I2C
+#include "lcd_i2c.h"                 // PCF8574 transport, also built on the host (Lcd/)
+#else
 /* ---------- LCD helpers ---------- */
 void lcd_pulse(void){
     LPC_GPIO0->FIOSET = LCD_EN; delay(100);
@@ -60,15 +177,24 @@ void lcd_init(void){
     lcd_cmd(0x01);   // Clear
     delay(3000);
 }
+#endif
 
 void lcd_string(const char *s){ while(*s) lcd_data(*s++); }
 
+#include "lcd_format.h"           // bounded row formatter (replaces sprintf)
+
 /* ---------- ADC on AD0.2 (P0.25) ---------- */
+// CLKDIV for ADC_CLK_HZ from the ADC's PCLK (CCLK/4)
+unsigned int adc_clkdiv(void){
+    unsigned int pclk = SystemCoreClock / 4;
+    return (pclk + ADC_CLK_HZ - 1) / ADC_CLK_HZ - 1;
+}
+
 void initADC(void){
     LPC_SC->PCONP |= (1 << 12);                // Power ADC
     LPC_PINCON->PINSEL1 &= ~(3 << 18);         // Clear bits for P0.25
     LPC_PINCON->PINSEL1 |=  (1 << 18);         // 01 -> P0.25 as AD0.2
-    LPC_ADC->ADCR = (1 << 2) | (4 << 8) | (1 << 21);  // channel 2, clkdiv, PDN
+    LPC_ADC->ADCR = (1 << 2) | (adc_clkdiv() << 8) | (1 << 21);  // channel 2, clkdiv, PDN
 }
 
 unsigned int readADC(void){
@@ -78,6 +204,222 @@ unsigned int readADC(void){
     return (LPC_ADC->ADGDR >> 4) & 0xFFF;      // 12-bit result
 }
 
+#if DETECT_MODE == DETECT_LOCKIN
+/* ---------- Lock-in (synchronous) detection ----------
+   PWM1 and TIMER0 both count PCLK = CCLK/4, and the PWM period is exactly
+   4 ADC trigger periods, so every sample lands on the same phase of the
+   laser waveform. Demodulation is lockin_sample() from lockin.h, the same
+   code Lockin/lockin_sim.c runs on the host.
+   ISR budget: ~12 cycles stacking + ~30 cycles body + ~12 unstacking,
+   i.e. < 60 cycles (0.6 us at 100 MHz) per sample; at 4 x 25 Hz that
+   is < 0.01 % of the CPU. The result hand-off runs once per window.
+--------------------------------------------------------*/
+#include "lockin.h"
+
+volatile int lockI, lockQ;          // latched window result
+volatile unsigned int lockDC;       // mean level over the window (ambient)
+volatile unsigned char lockReady = 0;
+lockin_acc lockAcc;
+
+RAMFUNC void ADC_IRQHandler(void){
+    ISR_ENTRY(t0);
+    int x = (LPC_ADC->ADDR2 >> 4) & 0xFFF;    // read clears DONE + IRQ
+
+    if(lockin_sample(&lockAcc, x, LOCKIN_CYCLES)){
+        lockI = lockAcc.winI; lockQ = lockAcc.winQ;
+        lockDC = lockAcc.winDC;
+        lockReady = 1;
+    }
+#if ISR_STATS
+    {
+        /* TIMER0 resets one tick after the MAT0.1 edge: (TC + 1) * 4 cycles
+           since the edge, less the conversion (65 ADC clocks) and the time
+           spent in here. TC and CYCCNT are read back to back. */
+        uint32_t conv = 65 * 4 * (((LPC_ADC->ADCR >> 8) & 0xFF) + 1);
+        uint32_t tc   = LPC_TIM0->TC;
+        uint32_t t1   = DWT->CYCCNT;
+        ISR_EXIT(adcStats, (tc + 1) * 4 - conv - (t1 - t0), t0);
+    }
+#endif
+}
+
+/* Both periods come from the same tick count (PWM1 counts MR0 + 1, TIMER0
+   MR1 + 1 per period), so the 8:1 ratio is exact at any PCLK. Called at
+   init and after every clock profile switch: the counters, the MAT0.1
+   level and the demodulator restart together, so no window mixes samples
+   taken at two phase alignments. */
+void lockin_timing(void){
+    unsigned int tick = (SystemCoreClock / 4) / (8 * LOCKIN_FMOD);
+
+    NVIC_DisableIRQ(ADC_IRQn);
+    LPC_PWM1->TCR = 0x02;                        // hold both in reset
+    LPC_TIM0->TCR = 0x02;
+    LPC_PWM1->MR0 = 8 * tick - 1;                // laser period
+    LPC_PWM1->MR1 = 4 * tick;                    // 50 % duty
+    LPC_PWM1->LER = 0x03;
+    LPC_TIM0->MR1 = tick - 1;                    // MAT0.1 toggle interval
+    LPC_TIM0->EMR = (3 << 6);                    // toggle, MAT0.1 level back to 0
+
+    /* Drop the window in progress */
+    (void)LPC_ADC->ADDR2;
+    lockin_reset(&lockAcc);
+    lockReady = 0;
+    NVIC_ClearPendingIRQ(ADC_IRQn);
+
+    /* Start both counters back to back: fixed phase from here on */
+    LPC_PWM1->TCR = 0x09;
+    LPC_TIM0->TCR = 0x01;
+    NVIC_EnableIRQ(ADC_IRQn);
+}
+
+void initLockin(void){
+    /* Laser modulation: PWM1.1 on P2.0 */
+    LPC_SC->PCONP |= (1 << 6);
+    LPC_PINCON->PINSEL4 = (LPC_PINCON->PINSEL4 & ~3) | 1;   // P2.0 = PWM1.1
+    LPC_PWM1->PR  = 0;
+    LPC_PWM1->MCR = 0x02;                        // reset on MR0
+    LPC_PWM1->PCR = (1 << 9);                    // enable PWM1.1 output
+
+    /* Sample clock: MAT0.1 toggles at 8 x FMOD -> rising edge at 4 x FMOD */
+    LPC_SC->PCONP |= (1 << 1);
+    LPC_TIM0->PR  = 0;
+    LPC_TIM0->MCR = (1 << 4);                    // reset on MR1
+    LPC_TIM0->EMR = (3 << 6);                    // MAT0.1 toggle
+
+    /* ADC: AD0.2, conversion started by MAT0.1 rising edge, IRQ on DONE */
+    LPC_ADC->ADCR = (1 << 2) | (adc_clkdiv() << 8) | (1 << 21) | (4 << 24);
+    LPC_ADC->ADINTEN = (1 << 2);
+
+    lockin_timing();                             // also enables the ADC IRQ
+}
+#endif
+
+#if TONE_ENABLE
+/* ---------- Tone synthesizer (DAC + GPDMA channel 0) ----------
+   Each wavetable block is 8 ms and holds whole cycles, so a pattern is
+   just a list of (table, blocks) steps. tone_build() turns every pattern
+   into a ring of linked-list items, one per block (one item for a run
+   of silence, source not incremented). The DAC counter paces the DMA at
+   TONE_FS; the last item links back to the first, so a pattern plays
+   until tone_stop() with no interrupts at all. A pattern that does not
+   fit in the TONE_LLI_MAX items left is not built and stays silent;
+   toneLliNeeded then shows (in the debugger) how large the pool must be.
+----------------------------------------------------------------*/
+#include "tone_tables.h"
+
+#define TONE_LLI_MAX 112
+#define TONE_NONE    0xFFFF         // toneFirst[] entry of a pattern left out
+#define DAC_MIDSCALE (512 << 6)
+
+typedef struct { uint8_t table, blocks; } tone_step;
+typedef struct { uint32_t src, dst, lli, ctrl; } dma_lli;   // GPDMA LLI layout
+
+const tone_step toneSiren[] = {
+    { TONE_T_625, 4 },  { TONE_T_750, 4 },  { TONE_T_875, 4 },  { TONE_T_1000, 4 },
+    { TONE_T_1125, 4 }, { TONE_T_1250, 4 }, { TONE_T_1375, 4 }, { TONE_T_1250, 4 },
+    { TONE_T_1125, 4 }, { TONE_T_1000, 4 }, { TONE_T_875, 4 },  { TONE_T_750, 4 },
+};
+const tone_step toneChirp[] = {
+    { TONE_T_2000, 1 }, { TONE_T_2500, 1 }, { TONE_T_3000, 1 }, { TONE_T_SILENCE, 22 },
+};
+const tone_step toneMulti[] = {
+    { TONE_T_DUAL_A, 25 }, { TONE_T_DUAL_B, 25 },
+};
+const struct { const tone_step *steps; unsigned char n; } tonePatterns[TONE_PATTERNS] = {
+    { toneSiren, sizeof(toneSiren) / sizeof(toneSiren[0]) },
+    { toneChirp, sizeof(toneChirp) / sizeof(toneChirp[0]) },
+    { toneMulti, sizeof(toneMulti) / sizeof(toneMulti[0]) },
+};
+
+dma_lli toneLli[TONE_LLI_MAX];
+uint16_t toneFirst[TONE_PATTERNS];          // first LLI of each pattern
+unsigned int toneLliNeeded = 0;             // items all patterns would take
+unsigned char tonePlaying = 0xFF;           // pattern on the DAC, 0xFF = off
+
+// Word-to-word, memory to DAC; SI only when walking a real table
+#define TONE_CTRL(n, si) ((n) | (2 << 18) | (2 << 21) | ((si) << 26))
+
+void tone_build(void){
+    unsigned int p, s, b, i = 0, first, n;
+
+    for(p = 0; p < TONE_PATTERNS; p++){
+        for(s = 0, n = 0; s < tonePatterns[p].n; s++){   // items this pattern takes
+            const tone_step *st = &tonePatterns[p].steps[s];
+            n += st->table == TONE_T_SILENCE ? 1 : st->blocks;
+        }
+        toneLliNeeded += n;
+        if(n == 0 || n > TONE_LLI_MAX - i){
+            toneFirst[p] = TONE_NONE;
+            continue;
+        }
+        first = i;
+        toneFirst[p] = first;
+        for(s = 0; s < tonePatterns[p].n; s++){
+            const tone_step *st = &tonePatterns[p].steps[s];
+            if(st->table == TONE_T_SILENCE){      // one item, same word repeated
+                toneLli[i].src  = (uint32_t)toneTable[TONE_T_SILENCE];
+                toneLli[i].ctrl = TONE_CTRL(st->blocks * TONE_BLOCK, 0);
+                i++;
+                continue;
+            }
+            for(b = 0; b < st->blocks; b++, i++){
+                toneLli[i].src  = (uint32_t)toneTable[st->table];
+                toneLli[i].ctrl = TONE_CTRL(TONE_BLOCK, 1);
+            }
+        }
+        for(s = first; s < i; s++){
+            toneLli[s].dst = (uint32_t)&LPC_DAC->DACR;
+            toneLli[s].lli = (uint32_t)&toneLli[s + 1 < i ? s + 1 : first];
+        }
+    }
+}
+
+// DAC counter reload for TONE_FS from the DAC's PCLK (CCLK/4)
+void tone_rate(void){
+    LPC_DAC->DACCNTVAL = (SystemCoreClock / 4) / TONE_FS - 1;
+}
+
+void tone_init(void){
+    LPC_SC->PCONP |= (1 << 29);                     // Power GPDMA
+    LPC_PINCON->PINSEL1 = (LPC_PINCON->PINSEL1 & ~(3 << 20)) | (2 << 20);   // P0.26 AOUT
+    LPC_DAC->DACR = DAC_MIDSCALE;
+    tone_rate();
+    LPC_GPDMA->DMACConfig = 1;                      // Enable GPDMA, little endian
+    tone_build();
+}
+
+void tone_stop(void){
+    LPC_GPDMACH0->DMACCConfig = 0;                  // channel off
+    LPC_DAC->DACCTRL = 0;                           // no more DMA requests
+    LPC_DAC->DACR = DAC_MIDSCALE;
+    tonePlaying = 0xFF;
+}
+
+void tone_start(unsigned char p){
+    const dma_lli *l;
+
+    if(p == tonePlaying) return;
+    tone_stop();
+    if(p >= TONE_PATTERNS || toneFirst[p] == TONE_NONE) return;
+    l = &toneLli[toneFirst[p]];
+    LPC_GPDMA->DMACIntTCClear = 0x01;
+    LPC_GPDMA->DMACIntErrClr  = 0x01;
+    LPC_GPDMACH0->DMACCSrcAddr  = l->src;
+    LPC_GPDMACH0->DMACCDestAddr = l->dst;
+    LPC_GPDMACH0->DMACCLLI      = l->lli;
+    LPC_GPDMACH0->DMACCControl  = l->ctrl;
+    LPC_GPDMACH0->DMACCConfig   = 1                 // Channel enable
+                                | (7 << 6)          // Dest peripheral: DAC
+                                | (1 << 11);        // Memory to peripheral
+    LPC_DAC->DACCTRL = (1 << 1) | (1 << 2) | (1 << 3);   // DBLBUF, CNT, DMA
+    tonePlaying = p;
+}
+
+/* ---------- Buzzer control (tone) ---------- */
+void buzzer_init(void){ tone_init(); }
+void buzzer_on(void){ tone_start(TONE_SIREN); }
+void buzzer_off(void){ tone_stop(); }
+#else
 /* ---------- Buzzer control ---------- */
 void buzzer_init(void){
     LPC_PINCON->PINSEL1 &= ~(3 << 12);  // P0.22 as GPIO
@@ -86,6 +428,7 @@ void buzzer_init(void){
 }
 void buzzer_on(void){ LPC_GPIO0->FIOSET = BUZZER_PIN; }
 void buzzer_off(void){ LPC_GPIO0->FIOCLR = BUZZER_PIN; }
+#endif
 
 /* ---------- SW1 (Reset) ---------- */
 void switch_init(void){
@@ -93,32 +436,381 @@ void switch_init(void){
     LPC_GPIO2->FIODIR &= ~(RESET_SW);    // Input
 }
 
+#if DETECT_MODE == DETECT_ZONES && TRACE_ENABLE
+/* ---------- Trace output (UART3) ----------
+   The ADC ISR appends whole records to traceQ, the UART3 THRE interrupt
+   refills the 16-byte TX FIFO from it. Both run at the same priority, so
+   neither preempts the other. A record that does not fit is dropped and
+   counted; the gap shows up in the scan numbers on the PC.
+--------------------------------------------*/
+volatile uint8_t traceQ[TRACE_QLEN];
+volatile uint8_t traceHead = 0, traceTail = 0;   // ADC ISR head, UART3 ISR tail
+volatile uint8_t traceBusy = 0;
+volatile uint32_t traceDrops = 0;
+
+// DLL + fractional divider for TRACE_BAUD from PCLK = CCLK (20 or 100 MHz)
+void trace_set_baud(void){
+    uint32_t pclk = SystemCoreClock, best = 0xFFFFFFFF, dl, m, a, rate, err;
+    uint32_t bestDl = 1, bestFdr = 0x10;
+
+    for(m = 1; m <= 15; m++){
+        for(a = 0; a < m; a++){
+            dl = (pclk * m + 8 * TRACE_BAUD * (m + a)) / (16 * TRACE_BAUD * (m + a));
+            if(dl == 0 || (a && dl < 3)) continue;      // UM: DL >= 3 with DIVADDVAL
+            rate = pclk * m / (16 * dl * (m + a));
+            err = rate > TRACE_BAUD ? rate - TRACE_BAUD : TRACE_BAUD - rate;
+            if(err < best){ best = err; bestDl = dl; bestFdr = (m << 4) | a; }
+        }
+    }
+    LPC_UART3->LCR = 0x83;                          // DLAB
+    LPC_UART3->DLL = bestDl & 0xFF;
+    LPC_UART3->DLM = bestDl >> 8;
+    LPC_UART3->FDR = bestFdr;
+    LPC_UART3->LCR = 0x03;                          // 8N1
+}
+
+void trace_init(void){
+    LPC_SC->PCONP |= (1 << 25);                     // Power UART3
+    LPC_SC->PCLKSEL1 = (LPC_SC->PCLKSEL1 & ~(3 << 18)) | (1 << 18);   // PCLK = CCLK
+    LPC_PINCON->PINSEL0 = (LPC_PINCON->PINSEL0 & ~3) | 2;             // P0.0 TXD3
+    trace_set_baud();
+    LPC_UART3->FCR = 0x07;                          // FIFOs on + reset
+    LPC_UART3->IER = (1 << 1);                      // THRE interrupt
+    NVIC_EnableIRQ(UART3_IRQn);
+}
+
+ISR_STATS_DEF(uart3Stats, "UART3 trace");      // exit cycles only
+
+void UART3_IRQHandler(void){
+    ISR_ENTRY(t0);
+    unsigned int n;
+
+    (void)LPC_UART3->IIR;                           // clears THRE
+    for(n = 0; n < 16 && traceTail != traceHead; n++){
+        LPC_UART3->THR = traceQ[traceTail];
+        traceTail++;
+    }
+    if(n == 0) traceBusy = 0;                       // queue drained
+    ISR_EXIT(uart3Stats, ISR_LAT_NONE, t0);
+}
+
+// Queue one record; len includes the checksum byte appended here.
+// Called from the RAM ADC ISR, so it lives in SRAM as well.
+RAMFUNC void trace_put(const uint8_t *rec, unsigned int len){
+    uint8_t room = (uint8_t)(traceTail - traceHead - 1), sum = 0;
+    unsigned int n;
+
+    if(room < len){ traceDrops++; return; }
+    for(n = 0; n < len - 1; n++){
+        traceQ[traceHead++] = rec[n];
+        sum ^= rec[n];
+    }
+    traceQ[traceHead++] = sum;
+    if(!traceBusy){
+        traceBusy = 1;
+        LPC_UART3->THR = traceQ[traceTail];         // THRE IRQ sends the rest
+        traceTail++;
+    }
+}
+#endif
+
+/* ---------- Clock profile manager ---------- */
+const struct {
+    unsigned char cclkcfg;          // CCLK = PLL0 / (cclkcfg + 1)
+    unsigned char delayDiv;         // 100 MHz / CCLK
+} clk_profiles[2] = {
+    { 19, 5 },                      // CLK_IDLE  : 20 MHz
+    {  3, 1 },                      // CLK_ALARM : 100 MHz
+};
+
+#if DETECT_MODE == DETECT_ZONES && TRACE_ENABLE
+void trace_hdr_rate(void);                  // zone section, needs ZONE_TRIP
+#endif
+
+// Re-derive every PCLK-based divider for the new SystemCoreClock
+void clock_apply(void){
+    LPC_ADC->ADCR = (LPC_ADC->ADCR & ~(0xFF << 8)) | (adc_clkdiv() << 8);
+#if LCD_TRANSPORT_I2C
+    i2c_set_rate();
+#endif
+#if DETECT_MODE == DETECT_LOCKIN
+    lockin_timing();
+#endif
+#if DETECT_MODE == DETECT_ZONES && TRACE_ENABLE
+    trace_set_baud();
+    trace_hdr_rate();                       // next 'H' carries the new scan rate
+#endif
+#if TONE_ENABLE
+    tone_rate();
+#endif
+}
+
+// FLASHCFG wait states: one more CPU clock per 20 MHz of CCLK
+void flash_set(uint32_t cclk){
+    uint32_t t = (cclk - 1) / 20000000;
+    if(t > 4) t = 4;
+    LPC_SC->FLASHCFG = (LPC_SC->FLASHCFG & 0xFFF) | (t << 12);   // reserved bits as read
+}
+
+void clock_set_profile(unsigned char p){
+    uint32_t pll, cclk;
+
+    if(p == clockProfile) return;
+    __disable_irq();
+    pll  = SystemCoreClock * (LPC_SC->CCLKCFG + 1);
+    cclk = pll / (clk_profiles[p].cclkcfg + 1);
+
+    /* More wait states before speeding up, fewer only after slowing down */
+    if(cclk > SystemCoreClock) flash_set(cclk);
+    LPC_SC->CCLKCFG = clk_profiles[p].cclkcfg;
+    if(cclk < SystemCoreClock) flash_set(cclk);
+    SystemCoreClockUpdate();
+    delayDiv = clk_profiles[p].delayDiv;
+    clock_apply();
+    clockProfile = p;
+    __enable_irq();
+}
+
+#if DETECT_MODE == DETECT_ZONES
+/* ---------- Multi-zone (AD0.0–AD0.7) ----------
+   All zone channels are enabled in one BURST scan. The ADC interrupts once
+   per scan (DONE of the highest zone channel) and ADC_IRQHandler runs a
+   single pass over the whole scan. Per-zone state is kept as parallel
+   arrays (struct of arrays), and the "tripped" / "broken" flags are
+   bitmasks indexed by channel, so the main loop reads all zones at once.
+   Per scan this costs one interrupt entry plus ~10 cycles per zone,
+   instead of eight start/wait/stop conversions and eight copies of the
+   threshold logic.
+   Pins: AD0.0 P0.23, AD0.1 P0.24, AD0.2 P0.25, AD0.3 P0.26,
+         AD0.4 P1.30, AD0.5 P1.31, AD0.6 P0.3,  AD0.7 P0.2
+-------------------------------------------------*/
+#define ZONE_LAST  (31 - __builtin_clz(ZONE_MASK))
+#if TRACE_ENABLE
+#define ZONE_DECIM TRACE_DECIM
+#else
+#define ZONE_DECIM 1
+#endif
+#define ZONE_TRIP  ((ZONE_TRIP_SCANS + ZONE_DECIM / 2) / ZONE_DECIM > 0 ? \
+                    (ZONE_TRIP_SCANS + ZONE_DECIM / 2) / ZONE_DECIM : 1)
+
+uint16_t zoneLevel[ZONE_COUNT];             // last sample per zone
+uint16_t zoneLo[ZONE_COUNT];                // trip threshold
+uint16_t zoneHi[ZONE_COUNT];                // restore threshold (hysteresis)
+uint16_t zoneRun[ZONE_COUNT];               // consecutive broken scans
+volatile uint8_t zoneBroken = 0;            // bit n: beam n currently broken
+volatile uint8_t zoneAlarm  = 0;            // bit n: alarm latched on zone n
+volatile uint32_t zoneScans = 0;
+#if TONE_ENABLE
+const unsigned char zoneTone[ZONE_COUNT] = {     // alarm pattern per zone
+    TONE_SIREN, TONE_SIREN, TONE_CHIRP, TONE_CHIRP,
+    TONE_MULTI, TONE_MULTI, TONE_SIREN, TONE_CHIRP,
+};
+#endif
+#if TRACE_ENABLE
+/* 'H' record, sent at start-up and again every TRACE_HDR_EVERY records so
+   a capture started at any time learns mask / trip / decim / scan rate
+   within ~0.5 s. Kept in SRAM (not const): the ISR resends it without
+   touching flash. The scan rate is filled in by trace_hdr_rate(). */
+uint8_t traceHdr[TRACE_HDR_LEN] = {
+    TRACE_HDR, ZONE_MASK,
+    ZONE_TRIP & 0xFF, ZONE_TRIP >> 8,
+    ZONE_TRIP_LO & 0xFF, ZONE_TRIP_LO >> 8,
+    ZONE_TRIP_HI & 0xFF, ZONE_TRIP_HI >> 8,
+    ZONE_DECIM
+};
+uint16_t traceSinceHdr = 0;                 // 'S' records since the last 'H'
+
+// Scan rate from the ADC clock actually programmed (PCLK / (CLKDIV + 1))
+void trace_hdr_rate(void){
+    uint32_t adcClk = (SystemCoreClock / 4) / (((LPC_ADC->ADCR >> 8) & 0xFF) + 1);
+    uint16_t hz = zone_scan_hz(adcClk, ZONE_MASK);
+    traceHdr[9] = hz & 0xFF;
+    traceHdr[10] = hz >> 8;
+}
+#endif
+
+void zones_init(void){
+    unsigned int z;
+
+    for(z = 0; z < ZONE_COUNT; z++){
+        zoneLo[z] = ZONE_TRIP_LO;
+        zoneHi[z] = ZONE_TRIP_HI;
+        zoneRun[z] = 0;
+    }
+
+    LPC_SC->PCONP |= (1 << 12);
+    if(ZONE_MASK & 0x01) LPC_PINCON->PINSEL1 = (LPC_PINCON->PINSEL1 & ~(3 << 14)) | (1 << 14);
+    if(ZONE_MASK & 0x02) LPC_PINCON->PINSEL1 = (LPC_PINCON->PINSEL1 & ~(3 << 16)) | (1 << 16);
+    if(ZONE_MASK & 0x04) LPC_PINCON->PINSEL1 = (LPC_PINCON->PINSEL1 & ~(3 << 18)) | (1 << 18);
+    if(ZONE_MASK & 0x08) LPC_PINCON->PINSEL1 = (LPC_PINCON->PINSEL1 & ~(3 << 20)) | (1 << 20);
+    if(ZONE_MASK & 0x10) LPC_PINCON->PINSEL3 |= (3 << 28);
+    if(ZONE_MASK & 0x20) LPC_PINCON->PINSEL3 |= (3u << 30);
+    if(ZONE_MASK & 0x40) LPC_PINCON->PINSEL0 = (LPC_PINCON->PINSEL0 & ~(3 << 6)) | (2 << 6);
+    if(ZONE_MASK & 0x80) LPC_PINCON->PINSEL0 = (LPC_PINCON->PINSEL0 & ~(3 << 4)) | (2 << 4);
+
+    LPC_ADC->ADCR = ZONE_MASK | (adc_clkdiv() << 8) | (1 << 16) | (1 << 21);   // BURST scan
+#if TRACE_ENABLE
+    trace_init();
+    trace_hdr_rate();
+    trace_put(traceHdr, TRACE_HDR_LEN);
+#endif
+    LPC_ADC->ADINTEN = (1 << ZONE_LAST);     // one IRQ per scan, ADGINTEN off
+    NVIC_EnableIRQ(ADC_IRQn);
+}
+
+#if TRACE_ENABLE
+// One 'S' record: scan number, SW1, all eight samples (ISR path, SRAM),
+// preceded by the 'H' record every TRACE_HDR_EVERY scans
+RAMFUNC void trace_scan(uint8_t inputs){
+    uint8_t rec[TRACE_SCAN_LEN];
+    uint32_t seq = zoneScans;
+    unsigned int z;
+
+    if(++traceSinceHdr >= TRACE_HDR_EVERY){
+        traceSinceHdr = 0;
+        trace_put(traceHdr, TRACE_HDR_LEN);
+    }
+    rec[0] = TRACE_SCAN;
+    rec[1] = seq; rec[2] = seq >> 8; rec[3] = seq >> 16; rec[4] = seq >> 24;
+    rec[5] = inputs;
+    for(z = 0; z < ZONE_COUNT; z++){
+        rec[6 + 2 * z] = zoneLevel[z] & 0xFF;
+        rec[7 + 2 * z] = zoneLevel[z] >> 8;
+    }
+    trace_put(rec, TRACE_SCAN_LEN);
+}
+#endif
+
+RAMFUNC void ADC_IRQHandler(void){
+    ISR_ENTRY(t0);
+    const volatile uint32_t *addr = &LPC_ADC->ADDR0;
+    uint8_t broken = zoneBroken, sw1;
+    unsigned int z;
+
+    for(z = 0; z < ZONE_COUNT; z++)
+        if(ZONE_MASK & (1 << z))
+            zoneLevel[z] = (addr[z] >> 4) & 0xFFF;   // reading clears DONE
+    zoneScans++;
+
+#if TRACE_ENABLE
+    if(zoneScans % ZONE_DECIM){ ISR_EXIT(adcStats, ISR_LAT_NONE, t0); return; }
+    sw1 = (LPC_GPIO2->FIOPIN & RESET_SW) == 0;
+    trace_scan(sw1 ? TRACE_IN_SW1 : 0);
+#else
+    sw1 = 0;                                 // main loop polls SW1
+#endif
+
+    zoneAlarm |= zone_scan(ZONE_MASK, ZONE_TRIP, zoneLevel, zoneLo, zoneHi, zoneRun, &broken);
+    zoneBroken = broken;
+    if(sw1) zoneAlarm &= broken;             // SW1: ack zones whose beam is back
+    ISR_EXIT(adcStats, ISR_LAT_NONE, t0);
+}
+
+void zones_status(char *line){
+    zone_status_line(line, LCD_COLS, ZONE_MASK, zoneBroken, zoneAlarm);
+}
+
+void zones_run(void){
+    uint8_t shown = 0xFF;
+
+    while(1){
+        uint8_t alarm = zoneAlarm;
+
+        if(alarm){
+            clock_set_profile(CLK_ALARM);
+#if TONE_ENABLE
+            tone_start(zoneTone[31 - __builtin_clz(alarm)]);   // highest zone
+#else
+            buzzer_on();
+#endif
+        }
+        else if(shown){ buzzer_off(); clock_set_profile(CLK_IDLE); }   // acked in the ISR
+        if(alarm != shown){
+            lcd_cmd(0x80);
+            if(alarm){
+                unsigned int z = 31 - __builtin_clz(alarm);
+                lcd_format(lcd_line, "INTRUDER ZONE %u", z);
+            }
+            else lcd_format(lcd_line, "Silent Intruder");
+            lcd_string(lcd_line);
+            shown = alarm;
+        }
+
+        zones_status(lcd_line);
+        lcd_cmd(0xC0);
+        lcd_string(lcd_line);
+
+#if !TRACE_ENABLE
+        /* SW1 acknowledges every zone whose beam is back */
+        if(alarm && (LPC_GPIO2->FIOPIN & RESET_SW) == 0){
+            __disable_irq();
+            zoneAlarm &= zoneBroken;
+            __enable_irq();
+            if(!zoneAlarm){ buzzer_off(); clock_set_profile(CLK_IDLE); }
+        }
+#endif
+
+        delay(200000);
+    }
+}
+#endif
+
 /* ---------- MAIN ---------- */
 int main(void){
     SystemInit();
     SystemCoreClockUpdate();
+    flash_set(SystemCoreClock);
+
+    isr_stats_start();                           // cycle counter for ISR timing
+    DWT->CYCCNT = 0;
 
     lcd_init();
     initADC();
+#if DETECT_MODE == DETECT_LOCKIN
+    initLockin();
+#elif DETECT_MODE == DETECT_ZONES
+    zones_init();
+#endif
     buzzer_init();
     switch_init();
 
     lcd_cmd(0x80);
     lcd_string("Silent Intruder");
+    clock_set_profile(CLK_IDLE);                 // armed and waiting
+
+#if DETECT_MODE == DETECT_ZONES
+    zones_run();                                 // never returns
+#else
 
     while(1){
+#if DETECT_MODE == DETECT_LOCKIN
+        while(!lockReady);                       // one window per pass
+        lockReady = 0;
+        lockAmp = lockin_amplitude(lockI, lockQ, LOCKIN_CYCLES);
+        adcVal  = lockDC;
+
+        lcd_cmd(0xC0);
+        lcd_format(lcd_line, "Amp:%4u DC:%4u", lockAmp, adcVal);
+        lcd_string(lcd_line);
+#else
         adcVal = readADC();
-        volts  = (adcVal * 3.3f) / 4095.0f;
+        centivolts = (adcVal * 330 + 2047) / 4095;
 
         lcd_cmd(0xC0);
-        sprintf(lcdBuffer, "Val:%4u  %.2fV", adcVal, volts);
-        lcd_string(lcdBuffer);
+        lcd_format(lcd_line, "Val:%4u  %.2uV", adcVal, centivolts);
+        lcd_string(lcd_line);
+#endif
 
         delay(1000000);   // Small delay for readability
 
         /* --- Intruder detection --- */
-        if(adcVal < 3650 && intruder_state == 0){  
+#if DETECT_MODE == DETECT_LOCKIN
+        if(lockAmp < LOCKIN_THRESHOLD && intruder_state == 0){
+#else
+        if(adcVal < BEAM_THRESHOLD && intruder_state == 0){  
+#endif
             intruder_state = 1;
+            clock_set_profile(CLK_ALARM);
             buzzer_on();
 
             lcd_cmd(0x01);         // Clear display
@@ -133,6 +825,7 @@ int main(void){
             if((LPC_GPIO2->FIOPIN & RESET_SW) == 0){  // Active LOW
                 buzzer_off();
                 intruder_state = 0;
+                clock_set_profile(CLK_IDLE);
 
                 lcd_cmd(0x01);  // Clear LCD after reset
                 delay(50000);
@@ -156,4 +849,5 @@ int main(void){
 
         delay(2000000);
     }
+#endif
 }
@@ -0,0 +1,230 @@
+/* ---------- LPC17xx.h for the host register simulator ----------
+   Stands in for the CMSIS header when a lab program is built on a PC
+   with -ISim (see Sim/sim.c). Register names are the CMSIS ones, but
+   every LPC_xxx / DWT / SysTick / CoreDebug / SCB expression goes through
+   sim_access(), which runs the peripheral models up to "now" and hands
+   back the register block. Only the registers the lab programs use are
+   modelled; the rest read back what was written.
+------------------------------------------------------------------*/
+#ifndef SIM_LPC17XX_H
+#define SIM_LPC17XX_H
+
+#include <stdint.h>
+
+#ifndef __I
+#define __I  volatile const         // sim.c writes them: it defines __I first
+#endif
+#define __O  volatile
+#define __IO volatile
+
+typedef enum {
+    SysTick_IRQn = -1,
+    WDT_IRQn = 0, TIMER0_IRQn, TIMER1_IRQn, TIMER2_IRQn, TIMER3_IRQn,
+    UART0_IRQn, UART1_IRQn, UART2_IRQn, UART3_IRQn, PWM1_IRQn,
+    I2C0_IRQn, I2C1_IRQn, I2C2_IRQn, SPI_IRQn, SSP0_IRQn, SSP1_IRQn,
+    PLL0_IRQn, RTC_IRQn, EINT0_IRQn, EINT1_IRQn, EINT2_IRQn, EINT3_IRQn,
+    ADC_IRQn, BOD_IRQn, USB_IRQn, CAN_IRQn, DMA_IRQn, I2S_IRQn, ENET_IRQn,
+    RIT_IRQn, MCPWM_IRQn, QEI_IRQn, PLL1_IRQn, USBActivity_IRQn, CANActivity_IRQn
+} IRQn_Type;
+
+/* ---------- Register blocks (all 32-bit words, CMSIS names) ---------- */
+typedef struct {
+    __IO uint32_t FLASHCFG; uint32_t r0[31];
+    __IO uint32_t PLL0CON, PLL0CFG; __I uint32_t PLL0STAT; __O uint32_t PLL0FEED; uint32_t r1[4];
+    __IO uint32_t PLL1CON, PLL1CFG; __I uint32_t PLL1STAT; __O uint32_t PLL1FEED; uint32_t r2[4];
+    __IO uint32_t PCON, PCONP; uint32_t r3[15];
+    __IO uint32_t CCLKCFG, USBCLKCFG, CLKSRCSEL; uint32_t r4[13];
+    __IO uint32_t EXTINT, EXTMODE, EXTPOLAR; uint32_t r5[12];
+    __IO uint32_t RSID; uint32_t r6[7];
+    __IO uint32_t SCS, IRCTRIM, PCLKSEL0, PCLKSEL1; uint32_t r7[4];
+    __IO uint32_t USBIntSt, DMAREQSEL, CLKOUTCFG;
+} LPC_SC_TypeDef;
+
+typedef struct {
+    __IO uint32_t PINSEL0, PINSEL1, PINSEL2, PINSEL3, PINSEL4, PINSEL5, PINSEL6,
+                  PINSEL7, PINSEL8, PINSEL9, PINSEL10; uint32_t r0[5];
+    __IO uint32_t PINMODE0, PINMODE1, PINMODE2, PINMODE3, PINMODE4, PINMODE5,
+                  PINMODE6, PINMODE7, PINMODE8, PINMODE9;
+    __IO uint32_t PINMODE_OD0, PINMODE_OD1, PINMODE_OD2, PINMODE_OD3, PINMODE_OD4;
+    __IO uint32_t I2CPADCFG;
+} LPC_PINCON_TypeDef;
+
+typedef struct {
+    __IO uint32_t FIODIR; uint32_t r0[3];
+    __IO uint32_t FIOMASK, FIOPIN, FIOSET;
+    __O  uint32_t FIOCLR;
+} LPC_GPIO_TypeDef;
+
+typedef struct {
+    __I  uint32_t IntStatus, IO0IntStatR, IO0IntStatF;
+    __O  uint32_t IO0IntClr;
+    __IO uint32_t IO0IntEnR, IO0IntEnF; uint32_t r0[3];
+    __I  uint32_t IO2IntStatR, IO2IntStatF;
+    __O  uint32_t IO2IntClr;
+    __IO uint32_t IO2IntEnR, IO2IntEnF;
+} LPC_GPIOINT_TypeDef;
+
+typedef struct {
+    __IO uint32_t IR, TCR, TC, PR, PC, MCR, MR0, MR1, MR2, MR3, CCR;
+    __I  uint32_t CR0, CR1; uint32_t r0[2];
+    __IO uint32_t EMR; uint32_t r1[12];
+    __IO uint32_t CTCR;
+} LPC_TIM_TypeDef;
+
+typedef struct {
+    __IO uint32_t IR, TCR, TC, PR, PC, MCR, MR0, MR1, MR2, MR3, CCR;
+    __I  uint32_t CR0, CR1, CR2, CR3; uint32_t r0;
+    __IO uint32_t MR4, MR5, MR6, PCR, LER; uint32_t r1[7];
+    __IO uint32_t CTCR;
+} LPC_PWM_TypeDef;
+
+typedef struct {
+    __IO uint32_t ADCR, ADGDR; uint32_t r0;
+    __IO uint32_t ADINTEN;
+    __I  uint32_t ADDR0, ADDR1, ADDR2, ADDR3, ADDR4, ADDR5, ADDR6, ADDR7, ADSTAT;
+    __IO uint32_t ADTRM;
+} LPC_ADC_TypeDef;
+
+typedef struct {
+    __IO uint32_t DACR, DACCTRL, DACCNTVAL;
+} LPC_DAC_TypeDef;
+
+/* RBR / THR / DLL and friends share an address on the chip; here each
+   has its own word so a write can be told from the byte last received. */
+typedef struct {
+    __I  uint32_t RBR;
+    __O  uint32_t THR;
+    __IO uint32_t DLL, DLM, IER;
+    __I  uint32_t IIR;
+    __O  uint32_t FCR;
+    __IO uint32_t LCR, MCR;
+    __I  uint32_t LSR, MSR;
+    __IO uint32_t SCR, ACR, FDR, TER;
+} LPC_UART_TypeDef;
+typedef LPC_UART_TypeDef LPC_UART0_TypeDef;
+typedef LPC_UART_TypeDef LPC_UART1_TypeDef;
+
+typedef struct {
+    __IO uint32_t I2CONSET;
+    __I  uint32_t I2STAT;
+    __IO uint32_t I2DAT, I2ADR0, I2SCLH, I2SCLL;
+    __O  uint32_t I2CONCLR;
+} LPC_I2C_TypeDef;
+
+typedef struct {
+    __IO uint32_t CR0, CR1, DR;
+    __I  uint32_t SR;
+    __IO uint32_t CPSR, IMSC, RIS, MIS, ICR, DMACR;
+} LPC_SSP_TypeDef;
+
+typedef struct {
+    __I  uint32_t DMACIntStat, DMACIntTCStat;
+    __O  uint32_t DMACIntTCClear;
+    __I  uint32_t DMACIntErrStat;
+    __O  uint32_t DMACIntErrClr;
+    __I  uint32_t DMACRawIntTCStat, DMACRawIntErrStat, DMACEnbldChns;
+    __IO uint32_t DMACSoftBReq, DMACSoftSReq, DMACSoftLBReq, DMACSoftLSReq;
+    __IO uint32_t DMACConfig, DMACSync;
+} LPC_GPDMA_TypeDef;
+
+typedef struct {
+    __IO uint32_t DMACCSrcAddr, DMACCDestAddr, DMACCLLI, DMACCControl, DMACCConfig;
+} LPC_GPDMACH_TypeDef;
+
+typedef struct {
+    __IO uint8_t  WDMOD; uint8_t r0[3];
+    __IO uint32_t WDTC;
+    __O  uint8_t  WDFEED; uint8_t r1[3];
+    __I  uint32_t WDTV;
+    __IO uint32_t WDCLKSEL;
+} LPC_WDT_TypeDef;
+
+typedef struct { __IO uint32_t CTRL, LOAD, VAL; __I uint32_t CALIB; } SysTick_Type;
+typedef struct { __IO uint32_t CTRL, CYCCNT; } DWT_Type;
+typedef struct { __IO uint32_t DHCSR, DCRSR, DCRDR, DEMCR; } CoreDebug_Type;
+typedef struct { __I uint32_t CPUID; __IO uint32_t ICSR, VTOR, AIRCR, SCR, CCR; } SCB_Type;
+
+/* ---------- Access hook ---------- */
+enum {
+    SIM_SC, SIM_PINCON, SIM_GPIO0, SIM_GPIO1, SIM_GPIO2, SIM_GPIO3, SIM_GPIO4,
+    SIM_GPIOINT, SIM_TIM0, SIM_TIM1, SIM_TIM2, SIM_TIM3, SIM_PWM1, SIM_ADC,
+    SIM_DAC, SIM_UART0, SIM_UART1, SIM_UART2, SIM_UART3, SIM_I2C0, SIM_I2C1,
+    SIM_I2C2, SIM_SSP0, SIM_SSP1, SIM_GPDMA, SIM_GPDMACH0, SIM_GPDMACH1,
+    SIM_WDT, SIM_SYSTICK, SIM_DWT, SIM_COREDEBUG, SIM_SCB, SIM_NPERIPH
+};
+void *sim_access(int periph);
+
+#define LPC_SC        ((LPC_SC_TypeDef *)sim_access(SIM_SC))
+#define LPC_PINCON    ((LPC_PINCON_TypeDef *)sim_access(SIM_PINCON))
+#define LPC_GPIO0     ((LPC_GPIO_TypeDef *)sim_access(SIM_GPIO0))
+#define LPC_GPIO1     ((LPC_GPIO_TypeDef *)sim_access(SIM_GPIO1))
+#define LPC_GPIO2     ((LPC_GPIO_TypeDef *)sim_access(SIM_GPIO2))
+#define LPC_GPIO3     ((LPC_GPIO_TypeDef *)sim_access(SIM_GPIO3))
+#define LPC_GPIO4     ((LPC_GPIO_TypeDef *)sim_access(SIM_GPIO4))
+#define LPC_GPIOINT   ((LPC_GPIOINT_TypeDef *)sim_access(SIM_GPIOINT))
+#define LPC_TIM0      ((LPC_TIM_TypeDef *)sim_access(SIM_TIM0))
+#define LPC_TIM1      ((LPC_TIM_TypeDef *)sim_access(SIM_TIM1))
+#define LPC_TIM2      ((LPC_TIM_TypeDef *)sim_access(SIM_TIM2))
+#define LPC_TIM3      ((LPC_TIM_TypeDef *)sim_access(SIM_TIM3))
+#define LPC_PWM1      ((LPC_PWM_TypeDef *)sim_access(SIM_PWM1))
+#define LPC_ADC       ((LPC_ADC_TypeDef *)sim_access(SIM_ADC))
+#define LPC_DAC       ((LPC_DAC_TypeDef *)sim_access(SIM_DAC))
+#define LPC_UART0     ((LPC_UART_TypeDef *)sim_access(SIM_UART0))
+#define LPC_UART1     ((LPC_UART_TypeDef *)sim_access(SIM_UART1))
+#define LPC_UART2     ((LPC_UART_TypeDef *)sim_access(SIM_UART2))
+#define LPC_UART3     ((LPC_UART_TypeDef *)sim_access(SIM_UART3))
+#define LPC_I2C0      ((LPC_I2C_TypeDef *)sim_access(SIM_I2C0))
+#define LPC_I2C1      ((LPC_I2C_TypeDef *)sim_access(SIM_I2C1))
+#define LPC_I2C2      ((LPC_I2C_TypeDef *)sim_access(SIM_I2C2))
+#define LPC_SSP0      ((LPC_SSP_TypeDef *)sim_access(SIM_SSP0))
+#define LPC_SSP1      ((LPC_SSP_TypeDef *)sim_access(SIM_SSP1))
+#define LPC_GPDMA     ((LPC_GPDMA_TypeDef *)sim_access(SIM_GPDMA))
+#define LPC_GPDMACH0  ((LPC_GPDMACH_TypeDef *)sim_access(SIM_GPDMACH0))
+#define LPC_GPDMACH1  ((LPC_GPDMACH_TypeDef *)sim_access(SIM_GPDMACH1))
+#define LPC_WDT       ((LPC_WDT_TypeDef *)sim_access(SIM_WDT))
+#define SysTick       ((SysTick_Type *)sim_access(SIM_SYSTICK))
+#define DWT           ((DWT_Type *)sim_access(SIM_DWT))
+#define CoreDebug     ((CoreDebug_Type *)sim_access(SIM_COREDEBUG))
+#define SCB           ((SCB_Type *)sim_access(SIM_SCB))
+
+#define SysTick_CTRL_ENABLE_Msk     (1UL << 0)
+#define SysTick_CTRL_TICKINT_Msk    (1UL << 1)
+#define SysTick_CTRL_CLKSOURCE_Msk  (1UL << 2)
+#define SysTick_CTRL_COUNTFLAG_Msk  (1UL << 16)
+#define DWT_CTRL_CYCCNTENA_Msk      (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk  (1UL << 24)
+#define SCB_SCR_SLEEPDEEP_Msk       (1UL << 2)
+
+/* ---------- System, NVIC and core intrinsics (Sim/sim.c) ---------- */
+extern uint32_t SystemCoreClock;
+void SystemInit(void);
+void SystemCoreClockUpdate(void);
+void NVIC_EnableIRQ(IRQn_Type irq);
+void NVIC_DisableIRQ(IRQn_Type irq);
+void NVIC_SetPendingIRQ(IRQn_Type irq);
+void NVIC_ClearPendingIRQ(IRQn_Type irq);
+void NVIC_SetPriority(IRQn_Type irq, uint32_t prio);
+uint32_t NVIC_GetPriority(IRQn_Type irq);
+uint32_t SysTick_Config(uint32_t ticks);
+void __enable_irq(void);
+void __disable_irq(void);
+void __NOP(void);
+void __WFI(void);
+void __DSB(void);
+void __ISB(void);
+
+/* Bit-band alias of a peripheral register bit (the programs define
+   BITBAND_SRAM only if it is not defined yet) */
+volatile uint32_t *sim_bitband(volatile void *reg, unsigned int bit);
+#define BITBAND_SRAM(addr, bit) (*sim_bitband((addr), (bit)))
+
+/* lcd_i2c.h waits for its queue to drain: sleep to the next event
+   instead of being caught spinning */
+#define I2C_WAIT() __WFI()
+
+/* isr_stats.h tables are collected from this section and printed. The
+   explicit alignment stops the compiler padding large objects apart, so
+   the section is a plain array. */
+#define ISR_STATS_SECTION __attribute__((section("isr_stats"), used, aligned(8)))
+
+#endif
@@ -0,0 +1,1205 @@
+/* ---------- LPC1768 register simulator (host) ----------
+   Runs a lab program unmodified on a PC. Sim/LPC17xx.h replaces the CMSIS
+   header, so every LPC_xxx / DWT / SysTick access calls sim_access(),
+   which
+     1. commits what the program wrote to the block it accessed last
+        (a changed word is a write; write-only registers read back as
+        SIM_WO so any value written to them shows up),
+     2. moves the model clock on by the cost of the access and runs the
+        peripheral models up to it (timers, PWM1, ADC, UARTs, I2C2 with a
+        PCF8574 + HD44780, SSP0 + GPDMA, GPIO interrupts, SysTick, DWT),
+     3. takes pending interrupts through an NVIC model (priorities,
+        nesting, 12-cycle stacking, 6-cycle tail chaining) by calling the
+        program's handlers, and
+     4. returns the block with its readable registers up to date.
+   Bit-band alias stores (BITBAND_SRAM) go the same way. A loop that
+   only polls RAM (while(!flag);) makes no accesses; a profiling timer
+   notices the CPU spinning and skips ahead to the next interrupt, like
+   __WFI().
+
+   Time is model cycles: register accesses (SIM_APB / SIM_AHB /
+   SIM_CORE), __NOP(), exception entry and exit. Plain CPU instructions
+   cost nothing and flash wait states are not modelled, so cycle counts
+   are the interrupt and bus component of what the board shows, not a
+   prediction of it. Event order, interrupt interplay and the ISR
+   bookkeeping itself are exercised for real.
+
+   Wiring of the simulated board:
+     MAT2.0 (P0.6) -> P0.0      ISR_BENCH.c GPIO source
+     PWM1.4 (P1.23) -> CAP2.0 (P0.4)    CAPTURE & LCD.c loopback
+     PWM1.1 (P2.0) drives the laser; AD0.2 sees it (lock-in mode)
+     AD0.0..7 ~3900 counts (beam present) +-8 noise; AD0.2 / zone 2
+       drops to ~1500 while the beam is broken (-b)
+     -d: AD0.4 = 2048 + 600 sin(2 pi 50 t), AD0.5 = 2048  (ADC & SSD.c)
+     SW1 (P2.12) pressed for 0.3 s at -s
+   UART0 is printed on stdout; UART3 goes to the -u file (zone trace,
+   readable by Trace/replay). The LCD (parallel on -l, or the PCF8574
+   backpack on I2C2) and the '595 chain on SSP0 are decoded and shown.
+   At the end every isr_stats.h table found in the program is printed.
+
+   Build : gcc -O2 -std=gnu99 -no-pie -ISim -Dmain=app_main -Wno-attributes
+               -Wno-pointer-to-int-cast -Wno-int-to-pointer-cast
+               -o prog "<program>.c" Sim/sim.c -lm
+   Use   : prog [-t seconds] [-b break_s] [-s sw1_s] [-l d4_pin] [-u file] [-d] [-v]
+           -t  model time to run (default 3 s; a program printing "done"
+               on UART0 stops there)
+           -l  parallel HD44780 on P0.<d4>..<d4+3>, RS next, EN after it
+               (23 for CAPTURE & LCD.c, 4 for SILENT_INTRUDER_ALERT.c)
+           -d  AD0.4 / AD0.5 as the differential pair of ADC & SSD.c
+           -v  log LCD rows and '595 frames as they change
+   Programs are built with -no-pie so (uint32_t) casts of RAM addresses
+   (GPDMA source / destination) survive on a 64-bit host.
+-----------------------------------------------------------*/
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <math.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <unistd.h>
+#define __I volatile                 // the models set the read-only registers
+#include "LPC17xx.h"
+#include "../isr_stats.h"
+
+#undef main
+int app_main(void);
+
+#define SIM_APB     3               // cycles per APB register access
+#define SIM_AHB     2               // GPIO / GPDMA
+#define SIM_CORE    1               // DWT, SysTick, SCB, CoreDebug
+#define SIM_STACK   12              // exception entry / exit
+#define SIM_CHAIN   6               // tail chaining
+#define SIM_WO      0xDEADBEEFu     // write-only registers read back as this
+#define PLL0_HZ     400000000.0     // SystemInit(): PLL0 at 400 MHz
+#define NEVER       UINT64_MAX
+
+#define W(type, field) (offsetof(type, field) / 4)
+
+/* ---------- Register blocks ---------- */
+LPC_SC_TypeDef       sim_sc;
+LPC_PINCON_TypeDef   sim_pincon;
+LPC_GPIO_TypeDef     sim_gpio[5];
+LPC_GPIOINT_TypeDef  sim_gpioint;
+LPC_TIM_TypeDef      sim_tim[4];
+LPC_PWM_TypeDef      sim_pwm1;
+LPC_ADC_TypeDef      sim_adc;
+LPC_DAC_TypeDef      sim_dac;
+LPC_UART_TypeDef     sim_uart[4];
+LPC_I2C_TypeDef      sim_i2c[3];
+LPC_SSP_TypeDef      sim_ssp[2];
+LPC_GPDMA_TypeDef    sim_gpdma;
+LPC_GPDMACH_TypeDef  sim_gpdmach[2];
+LPC_WDT_TypeDef      sim_wdt;
+SysTick_Type         sim_systick;
+DWT_Type             sim_dwt;
+CoreDebug_Type       sim_coredebug;
+SCB_Type             sim_scb;
+
+uint32_t SystemCoreClock = 4000000;  // IRC until SystemInit()
+
+/* ---------- Model state ---------- */
+static uint64_t now;                // model time, CPU cycles
+static double   nowSec;             // model time, seconds (CCLK changes)
+static double   cclk = 4000000;
+static uint64_t nextEvt = NEVER;    // earliest pending peripheral event
+static double   limitSec = 3.0, breakSec = 1.0, breakLen = 0.6, swSec = 2.5;
+static int      verbose, lcdD4 = -1, diffIn;
+static FILE    *uart3File;
+static volatile sig_atomic_t inCore;
+static int      lastPeriph = -1;    // block the program may have written
+static unsigned long entries;       // sim entries, to tell a RAM spin
+static uint32_t rng = 1;
+
+static void advance(uint64_t cycles);
+static void dispatch(void);
+static void finish(const char *why);
+static void recompute(void);
+
+static uint32_t pclkdiv(int reg, int shift){
+    static const uint8_t div[4] = { 4, 1, 2, 8 };
+    return div[((reg ? sim_sc.PCLKSEL1 : sim_sc.PCLKSEL0) >> shift) & 3];
+}
+
+/* ---------- Board scenario ---------- */
+static int beam_broken(void){ return nowSec >= breakSec && nowSec < breakSec + breakLen; }
+
+static int noise(void){
+    rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5;
+    return (int)(rng % 17) - 8;
+}
+
+static int laserOn;                 // PWM1.1 level
+
+static uint32_t analog(int ch){
+    int v = 3900;
+    if(ch == 2){
+        if(sim_pwm1.PCR & (1 << 9)) v = 1200 + (laserOn && !beam_broken() ? 1600 : 0);
+        else if(beam_broken()) v = 1500;
+    }
+    else if(ch == 4 && diffIn) v = 2048 + (int)lround(600 * sin(2 * M_PI * 50 * nowSec));
+    else if(ch == 5 && diffIn) v = 2048;
+    v += noise();
+    return v < 0 ? 0 : v > 4095 ? 4095 : v;
+}
+
+/* ---------- HD44780 (parallel on GPIO0, or behind the PCF8574) ---------- */
+static struct {
+    uint8_t ddram[0x80], ac, mode8, hi, haveHi, used;
+    char shown[2][17];
+} hd = { .mode8 = 1 };
+
+static void hd_row(int r, char *out){
+    int c;
+    for(c = 0; c < 16; c++){
+        uint8_t ch = hd.ddram[r * 0x40 + c];
+        out[c] = (ch >= 32 && ch < 127) ? ch : '?';
+    }
+    out[16] = '\0';
+}
+
+static void hd_exec(int rs, uint8_t v){
+    int r;
+    hd.used = 1;
+    if(rs){ hd.ddram[hd.ac & 0x7F] = v; hd.ac = (hd.ac + 1) & 0x7F; return; }
+    if(v == 0x01){ memset(hd.ddram, ' ', sizeof(hd.ddram)); hd.ac = 0; }
+    else if((v & 0xFE) == 0x02) hd.ac = 0;
+    else if(v & 0x80) hd.ac = v & 0x7F;
+    else if((v & 0xE0) == 0x20) hd.mode8 = (v >> 4) & 1;
+    if(!verbose) return;
+    for(r = 0; r < 2; r++){                       // a command ends a row update
+        char row[17];
+        hd_row(r, row);
+        if(strcmp(row, hd.shown[r])){
+            printf("[%9.6f] LCD%d |%s|\n", nowSec, r + 1, row);
+            strcpy(hd.shown[r], row);
+        }
+    }
+}
+
+static void hd_nibble(int rs, uint8_t n){
+    if(hd.mode8){ hd_exec(rs, n << 4); return; }
+    if(!hd.haveHi){ hd.hi = n; hd.haveHi = 1; return; }
+    hd.haveHi = 0;
+    hd_exec(rs, (hd.hi << 4) | n);
+}
+
+/* ---------- GPIO + GPIO interrupts ---------- */
+static uint32_t gpioOut[5], gpioIn[5] = { ~0x11u, ~0u, ~0u, ~0u, ~0u };   // jumpered P0.0 / P0.4 low
+static uint32_t intEnR[3], intEnF[3], intStatR[3], intStatF[3];
+static uint8_t srBytes[8], srLatched[8];
+static unsigned int srCount, srLatches;
+
+static void capture_edge(int tim, int cap, int level);
+
+static void gpio_input(int port, int bit, int level){
+    uint32_t m = 1u << bit, old = gpioIn[port];
+    gpioIn[port] = level ? old | m : old & ~m;
+    if(gpioIn[port] == old) return;
+    if(port == 0 || port == 2){
+        int p = port >> 1;
+        if(level && (intEnR[p] & m)) intStatR[p] |= m;
+        if(!level && (intEnF[p] & m)) intStatF[p] |= m;
+    }
+    if(port == 0 && bit == 4) capture_edge(2, 0, level);     // CAP2.0
+    if(port == 0 && bit == 5) capture_edge(2, 1, level);     // CAP2.1
+}
+
+static void gpio_output(int port, uint32_t v){
+    uint32_t old = gpioOut[port], fell = old & ~v, rose = v & ~old;
+    gpioOut[port] = v;
+    if(port != 0) return;
+    if(lcdD4 >= 0 && (fell & (1u << (lcdD4 + 5))))           // EN falling edge
+        hd_nibble((v >> (lcdD4 + 4)) & 1, (v >> lcdD4) & 0xF);
+    if((rose & (1u << 16)) && srCount){                      // '595 RCLK
+        srLatches++;
+        if(verbose && memcmp(srLatched, srBytes + 3, 5))
+            printf("[%9.6f] 595  %02X %02X %02X %02X %02X\n", nowSec,
+                   srBytes[3], srBytes[4], srBytes[5], srBytes[6], srBytes[7]);
+        memcpy(srLatched, srBytes + 3, 5);                   // last five shifted
+    }
+}
+
+static uint32_t gpio_pin(int port){
+    uint32_t dir = sim_gpio[port].FIODIR;
+    uint32_t in = gpioIn[port];
+    if(port == 2) in = swSec >= 0 && nowSec >= swSec && nowSec < swSec + 0.3 ? in & ~(1u << 12) : in;
+    return (gpioOut[port] & dir) | (in & ~dir);
+}
+
+/* ---------- Timers and PWM1 ----------
+   TC(t) = tcBase + (t - base) / tick for t >= base; before base (the
+   tick after a reset-on-match) TC still holds the matched value. */
+typedef struct {
+    int running, pwm;
+    uint64_t base, from;            // events before 'from' are done
+    uint32_t tcBase, held, tick;
+    uint32_t ir, em, mr[7], mcr, emr, ccr, pcr, cr[4], pr;
+    uint64_t next;
+} counter;
+static counter ctr[5];              // TIMER0..3, PWM1
+
+static void pin_event(int ctrIdx, int out, int level);
+
+static uint32_t ctr_tick(int i){
+    static const uint8_t sel[5][2] = { { 0, 2 }, { 0, 4 }, { 1, 12 }, { 1, 14 }, { 0, 12 } };
+    return pclkdiv(sel[i][0], sel[i][1]) * (ctr[i].pr + 1);
+}
+
+static uint32_t ctr_tc(counter *c, uint64_t t){
+    if(!c->running) return c->tcBase;
+    if(t < c->base) return c->held;
+    return c->tcBase + (uint32_t)((t - c->base) / c->tick);
+}
+
+static void ctr_rebase(int i){
+    counter *c = &ctr[i];
+    c->tcBase = ctr_tc(c, now);
+    c->base = now;
+    c->tick = ctr_tick(i);
+    c->from = now;
+}
+
+static int ctr_mr_used(counter *c, int n){
+    if((c->mcr >> (3 * n)) & 7) return 1;
+    if(!c->pwm) return n < 4 && ((c->emr >> (4 + 2 * n)) & 3);
+    return n == 0 ? (c->pcr & 0x7E00) != 0 : (c->pcr >> (8 + n)) & 1;
+}
+
+static uint64_t ctr_match_time(counter *c, int n){
+    uint32_t v = c->mr[n];
+    uint64_t t;
+    if(v < c->tcBase) return NEVER;
+    t = c->base + (uint64_t)(v - c->tcBase) * c->tick;
+    return t >= c->from ? t : NEVER;
+}
+
+static void ctr_next(counter *c){
+    int n, nmr = c->pwm ? 7 : 4;
+    c->next = NEVER;
+    if(!c->running) return;
+    for(n = 0; n < nmr; n++)
+        if(ctr_mr_used(c, n)){
+            uint64_t t = ctr_match_time(c, n);
+            if(t < c->next) c->next = t;
+        }
+}
+
+static void ctr_event(int i){
+    counter *c = &ctr[i];
+    uint64_t t = c->next;
+    int n, nmr = c->pwm ? 7 : 4, reset = 0;
+
+    for(n = 0; n < nmr; n++){
+        uint32_t act;
+        if(!ctr_mr_used(c, n) || ctr_match_time(c, n) != t) continue;
+        act = (c->mcr >> (3 * n)) & 7;
+        if(act & 1) c->ir |= 1u << n;
+        if(act & 2) reset = 1;
+        if(act & 4){ c->running = 0; c->tcBase = c->mr[n]; }
+        if(!c->pwm && n < 4){
+            uint32_t e = (c->emr >> (4 + 2 * n)) & 3, old = (c->em >> n) & 1, lv = old;
+            if(e == 1) lv = 0; else if(e == 2) lv = 1; else if(e == 3) lv = !old;
+            c->em = (c->em & ~(1u << n)) | (lv << n);
+            if(lv != old) pin_event(i, n, lv);
+        }
+        if(c->pwm && n > 0 && ((c->pcr >> (8 + n)) & 1) && ((c->em >> n) & 1)){
+            c->em &= ~(1u << n);
+            pin_event(i, n, 0);
+        }
+    }
+    if(reset && c->running){
+        c->held = ctr_tc(c, t);
+        c->tcBase = 0;
+        c->base = t + c->tick;
+        if(c->pwm){                               // single-edge outputs go high
+            for(n = 1; n < 7; n++)
+                if(((c->pcr >> (8 + n)) & 1) && !((c->em >> n) & 1) && c->mr[n] != 0){
+                    c->em |= 1u << n;
+                    pin_event(i, n, 1);
+                }
+        }
+    }
+    c->from = t + 1;
+    ctr_next(c);
+}
+
+static void capture_edge(int tim, int cap, int level){
+    counter *c = &ctr[tim];
+    uint32_t ccr = c->ccr >> (3 * cap);
+    if(!((level && (ccr & 1)) || (!level && (ccr & 2)))) return;
+    c->cr[cap] = ctr_tc(c, now);
+    if(ccr & 4) c->ir |= 1u << (4 + cap);
+}
+
+/* ---------- ADC ---------- */
+static struct {
+    int ch;                         // converting channel, -1 idle
+    uint64_t done;
+    uint32_t value, dr[8], gdr;
+} adc = { -1, NEVER };
+
+static void adc_start(int ch){
+    uint32_t clk = pclkdiv(0, 24) * (((sim_adc.ADCR >> 8) & 0xFF) + 1);
+    adc.ch = ch;
+    adc.value = analog(ch);                       // sample and hold
+    adc.done = now + 65ull * clk;
+}
+
+static int adc_first(int after){
+    int n;
+    for(n = 1; n <= 8; n++){
+        int ch = (after + n) & 7;
+        if(sim_adc.ADCR & (1u << ch)) return ch;
+    }
+    return -1;
+}
+
+static void adc_event(void){
+    int ch = adc.ch, nxt;
+    uint32_t r = (1u << 31) | (adc.value << 4);
+    if(adc.dr[ch] & (1u << 31)) r |= 1u << 30;  // overrun
+    adc.dr[ch] = r;
+    adc.gdr = r | ((uint32_t)ch << 24);
+    adc.ch = -1;
+    adc.done = NEVER;
+    if((sim_adc.ADCR & (1 << 16)) && (sim_adc.ADCR & (1 << 21)) && (nxt = adc_first(ch)) >= 0)
+        adc_start(nxt);
+}
+
+static void pin_event(int ctrIdx, int out, int level){
+    static const int8_t startSrc[4][2] = { { 0, 1 }, { 0, 3 }, { 1, 0 }, { 1, 1 } };
+    uint32_t start = (sim_adc.ADCR >> 24) & 7, edge = (sim_adc.ADCR >> 27) & 1;
+    if(ctrIdx < 4 && start >= 4 && startSrc[start - 4][0] == ctrIdx && startSrc[start - 4][1] == out
+       && level != (int)edge && adc.ch < 0 && (sim_adc.ADCR & (1 << 21))){
+        int ch = adc_first(7);
+        if(ch >= 0) adc_start(ch);
+    }
+    if(ctrIdx == 2 && out == 0) gpio_input(0, 0, level);     // MAT2.0 jumper -> P0.0
+    if(ctrIdx == 4 && out == 4) gpio_input(0, 4, level);     // PWM1.4 jumper -> CAP2.0
+    if(ctrIdx == 4 && out == 1) laserOn = level;             // PWM1.1 -> laser
+}
+
+/* ---------- UARTs ---------- */
+typedef struct {
+    uint8_t tx[16], rx[16];
+    int txn, rxn, shifting, thre, rxPend;
+    uint8_t shiftByte, rxByte;
+    uint64_t shiftEnd, rxAt;
+    char line[256];
+    int lineLen;
+} uart_m;
+static uart_m uart[4];
+
+static uint64_t uart_bit(int u){
+    static const uint8_t sel[4][2] = { { 0, 6 }, { 0, 8 }, { 1, 16 }, { 1, 18 } };
+    LPC_UART_TypeDef *r = &sim_uart[u];
+    uint32_t dl = ((r->DLM & 0xFF) << 8) | (r->DLL & 0xFF), mul = (r->FDR >> 4) & 0xF, add = r->FDR & 0xF;
+    if(!dl) dl = 1;
+    if(!mul){ mul = 1; add = 0; }
+    return (uint64_t)llround(pclkdiv(sel[u][0], sel[u][1]) * 16.0 * dl * (mul + add) / mul);
+}
+
+static int uart_bits(int u){
+    uint32_t lcr = sim_uart[u].LCR;
+    return 1 + 5 + (lcr & 3) + ((lcr >> 3) & 1) + 1 + ((lcr >> 2) & 1);
+}
+
+static void uart_shift(int u){
+    uart_m *m = &uart[u];
+    uint64_t bit = uart_bit(u);
+    m->shiftByte = m->tx[0];
+    memmove(m->tx, m->tx + 1, --m->txn);
+    m->shifting = 1;
+    m->shiftEnd = now + bit * uart_bits(u);
+    if(!m->txn) m->thre = 1;
+    if(u == 1 && (sim_uart[1].MCR & (1 << 4))){   // loopback: RDA mid stop bit
+        m->rxPend = 1;
+        m->rxByte = m->shiftByte;
+        m->rxAt = now + bit * uart_bits(u) - bit / 2;
+    }
+}
+
+static void uart_sink(int u, uint8_t b){
+    uart_m *m = &uart[u];
+    if(u == 3 && uart3File) fputc(b, uart3File);
+    if(u != 0) return;
+    if(b == '\r') return;
+    if(b != '\n' && m->lineLen < (int)sizeof(m->line) - 1){ m->line[m->lineLen++] = b; return; }
+    m->line[m->lineLen] = '\0';
+    printf("%s\n", m->line);
+    m->lineLen = 0;
+    if(!strcmp(m->line, "done")) finish("program printed done");
+}
+
+static uint64_t uart_next(int u){
+    uart_m *m = &uart[u];
+    uint64_t t = m->shifting ? m->shiftEnd : NEVER;
+    return m->rxPend && m->rxAt < t ? m->rxAt : t;
+}
+
+static void uart_event(int u){
+    uart_m *m = &uart[u];
+    if(m->rxPend && m->rxAt <= now){
+        m->rxPend = 0;
+        if(m->rxn < 16) m->rx[m->rxn++] = m->rxByte;
+    }
+    if(m->shifting && m->shiftEnd <= now){
+        m->shifting = 0;
+        uart_sink(u, m->shiftByte);
+        if(m->txn) uart_shift(u);
+    }
+}
+
+/* ---------- I2C2 master + PCF8574 backpack ---------- */
+#define I2C_STA 0x20
+#define I2C_STO 0x10
+#define I2C_SI  0x08
+enum { I2C_OP_NONE, I2C_OP_START, I2C_OP_BYTE, I2C_OP_STOP };
+static struct {
+    uint32_t con, stat, dat;
+    int op, inTx, addrPhase;
+    uint64_t at;
+    uint8_t pins;
+    unsigned long bytes, nacks;
+} i2c = { .stat = 0xF8, .at = NEVER, .pins = 0xFF };
+
+static uint64_t i2c_bit(void){
+    uint32_t n = (sim_i2c[2].I2SCLH & 0xFFFF) + (sim_i2c[2].I2SCLL & 0xFFFF);
+    return (uint64_t)pclkdiv(1, 20) * (n < 8 ? 8 : n);
+}
+
+static void i2c_schedule(int op, int bits){ i2c.op = op; i2c.at = now + i2c_bit() * bits; }
+
+static void i2c_kick(void){                       // after a CONSET / CONCLR write
+    if(i2c.op != I2C_OP_NONE || (i2c.con & I2C_SI) || !(i2c.con & 0x40)) return;
+    if(i2c.con & I2C_STO){
+        if(i2c.inTx) i2c_schedule(I2C_OP_STOP, 1);
+        else i2c.con &= ~I2C_STO;
+    }
+    else if(i2c.con & I2C_STA) i2c_schedule(I2C_OP_START, 1);
+}
+
+static void pcf_write(uint8_t b){
+    if((i2c.pins & 0x04) && !(b & 0x04)) hd_nibble(i2c.pins & 1, i2c.pins >> 4);   // EN falls
+    i2c.pins = b;
+    i2c.bytes++;
+}
+
+static void i2c_event(void){
+    int op = i2c.op;
+    i2c.op = I2C_OP_NONE;
+    i2c.at = NEVER;
+    switch(op){
+        case I2C_OP_START:
+            i2c.stat = i2c.inTx ? 0x10 : 0x08;
+            i2c.inTx = i2c.addrPhase = 1;
+            i2c.con |= I2C_SI;
+            break;
+        case I2C_OP_BYTE:
+            if(i2c.addrPhase){
+                int ack = !(i2c.dat & 1) && ((i2c.dat >> 1) & 0x78) == 0x20;  // PCF8574 0x20-0x27
+                i2c.stat = ack ? 0x18 : 0x20;
+                if(!ack) i2c.nacks++;
+                i2c.addrPhase = 0;
+            }
+            else{
+                pcf_write(i2c.dat);
+                i2c.stat = 0x28;
+            }
+            i2c.con |= I2C_SI;
+            break;
+        case I2C_OP_STOP:
+            i2c.inTx = 0;
+            i2c.con &= ~I2C_STO;
+            i2c.stat = 0xF8;
+            i2c_kick();                           // STA still set: new START
+            break;
+    }
+}
+
+/* ---------- SSP0 + GPDMA ---------- */
+static uint64_t sspBusy;
+static struct { uint64_t tcAt; int active; } dmaCh[2] = { { NEVER, 0 }, { NEVER, 0 } };
+static uint32_t dmaTC, dmaErr;
+
+static uint64_t ssp_byte(void){
+    return 8ull * pclkdiv(1, 10) * (sim_ssp[0].CPSR & 0xFF) * (((sim_ssp[0].CR0 >> 8) & 0xFF) + 1);
+}
+
+static void ssp_push(uint8_t b){
+    memmove(srBytes, srBytes + 1, sizeof(srBytes) - 1);     // keep the last 8
+    srBytes[sizeof(srBytes) - 1] = b;
+    srCount++;
+}
+
+static void dma_start(int ch){
+    LPC_GPDMACH_TypeDef *r = &sim_gpdmach[ch];
+    uint32_t n = r->DMACCControl & 0xFFF, k, dst = (r->DMACCConfig >> 6) & 0x1F;
+    uint8_t *src = (uint8_t *)(uintptr_t)r->DMACCSrcAddr;
+    uint64_t bt = ssp_byte();
+
+    dmaCh[ch].active = 1;
+    dmaCh[ch].tcAt = NEVER;
+    if(!(sim_gpdma.DMACConfig & 1) || dst != 0 || ((r->DMACCConfig >> 11) & 7) != 1)
+        return;                                   // only memory -> SSP0 TX is timed
+    for(k = 0; k < n; k++){
+        ssp_push(*src);
+        if(r->DMACCControl & (1u << 26)) src++;
+    }
+    if(sspBusy < now) sspBusy = now;
+    sspBusy += n * bt;
+    dmaCh[ch].tcAt = now + (n > 8 ? (n - 8) * bt : 0) + 2 * n;   // last byte into the FIFO
+}
+
+static void dma_event(int ch){
+    LPC_GPDMACH_TypeDef *r = &sim_gpdmach[ch];
+    dmaCh[ch].active = 0;
+    dmaCh[ch].tcAt = NEVER;
+    r->DMACCConfig &= ~1u;
+    if((r->DMACCControl & (1u << 31)) && (r->DMACCConfig & (1u << 15))) dmaTC |= 1u << ch;
+}
+
+/* ---------- SysTick and DWT ---------- */
+static uint64_t sysBase, sysNext = NEVER, cycBase;
+static uint32_t cycFrozen;
+static int sysPend;
+
+static int dwt_on(void){ return (sim_coredebug.DEMCR & (1u << 24)) && (sim_dwt.CTRL & 1); }
+
+/* ---------- Events ---------- */
+static void recompute(void){
+    int i;
+    uint64_t t = adc.done;
+    for(i = 0; i < 5; i++) if(ctr[i].next < t) t = ctr[i].next;
+    for(i = 0; i < 4; i++){ uint64_t u = uart_next(i); if(u < t) t = u; }
+    if(i2c.at < t) t = i2c.at;
+    for(i = 0; i < 2; i++) if(dmaCh[i].tcAt < t) t = dmaCh[i].tcAt;
+    if(sysNext < t) t = sysNext;
+    nextEvt = t;
+}
+
+static void run_events(void){
+    int i;
+    if(adc.done <= now) adc_event();
+    for(i = 0; i < 5; i++) if(ctr[i].next <= now) ctr_event(i);
+    for(i = 0; i < 4; i++) if(uart_next(i) <= now) uart_event(i);
+    if(i2c.at <= now) i2c_event();
+    for(i = 0; i < 2; i++) if(dmaCh[i].tcAt <= now) dma_event(i);
+    if(sysNext <= now){
+        uint32_t period = (sim_systick.LOAD & 0xFFFFFF) + 1;
+        sim_systick.CTRL |= SysTick_CTRL_COUNTFLAG_Msk;
+        if(sim_systick.CTRL & SysTick_CTRL_TICKINT_Msk) sysPend = 1;
+        sysBase = sysNext;
+        sysNext += period;
+    }
+    recompute();
+}
+
+static void set_now(uint64_t t){
+    if(t < now) t = now;
+    nowSec += (t - now) / cclk;
+    now = t;
+    if(nowSec >= limitSec) finish("time limit");
+}
+
+static void advance(uint64_t cycles){
+    uint64_t target = now + cycles;
+    while(nextEvt <= target){
+        set_now(nextEvt);
+        run_events();
+    }
+    set_now(target);
+}
+
+/* ---------- NVIC ---------- */
+#define NIRQ      35
+#define SYSTICK_X NIRQ              // slot of the SysTick exception
+static uint8_t nvEn[NIRQ + 1], nvPend[NIRQ + 1], nvActive[NIRQ + 1], nvPrio[NIRQ + 1];
+static int primask, curPrio = 256;
+
+typedef void (*handler)(void);
+
+#define WEAK(name) void name(void) __attribute__((weak)); \
+                   void name(void){ fprintf(stderr, "sim: no " #name "\n"); finish("unhandled interrupt"); }
+WEAK(WDT_IRQHandler)    WEAK(TIMER0_IRQHandler) WEAK(TIMER1_IRQHandler) WEAK(TIMER2_IRQHandler)
+WEAK(TIMER3_IRQHandler) WEAK(UART0_IRQHandler)  WEAK(UART1_IRQHandler)  WEAK(UART2_IRQHandler)
+WEAK(UART3_IRQHandler)  WEAK(PWM1_IRQHandler)   WEAK(I2C0_IRQHandler)   WEAK(I2C1_IRQHandler)
+WEAK(I2C2_IRQHandler)   WEAK(SPI_IRQHandler)    WEAK(SSP0_IRQHandler)   WEAK(SSP1_IRQHandler)
+WEAK(PLL0_IRQHandler)   WEAK(RTC_IRQHandler)    WEAK(EINT0_IRQHandler)  WEAK(EINT1_IRQHandler)
+WEAK(EINT2_IRQHandler)  WEAK(EINT3_IRQHandler)  WEAK(ADC_IRQHandler)    WEAK(BOD_IRQHandler)
+WEAK(USB_IRQHandler)    WEAK(CAN_IRQHandler)    WEAK(DMA_IRQHandler)    WEAK(I2S_IRQHandler)
+WEAK(ENET_IRQHandler)   WEAK(RIT_IRQHandler)    WEAK(MCPWM_IRQHandler)  WEAK(QEI_IRQHandler)
+WEAK(PLL1_IRQHandler)   WEAK(USBActivity_IRQHandler) WEAK(CANActivity_IRQHandler)
+WEAK(SysTick_Handler)
+
+static const handler vectors[NIRQ + 1] = {
+    WDT_IRQHandler, TIMER0_IRQHandler, TIMER1_IRQHandler, TIMER2_IRQHandler,
+    TIMER3_IRQHandler, UART0_IRQHandler, UART1_IRQHandler, UART2_IRQHandler,
+    UART3_IRQHandler, PWM1_IRQHandler, I2C0_IRQHandler, I2C1_IRQHandler,
+    I2C2_IRQHandler, SPI_IRQHandler, SSP0_IRQHandler, SSP1_IRQHandler,
+    PLL0_IRQHandler, RTC_IRQHandler, EINT0_IRQHandler, EINT1_IRQHandler,
+    EINT2_IRQHandler, EINT3_IRQHandler, ADC_IRQHandler, BOD_IRQHandler,
+    USB_IRQHandler, CAN_IRQHandler, DMA_IRQHandler, I2S_IRQHandler,
+    ENET_IRQHandler, RIT_IRQHandler, MCPWM_IRQHandler, QEI_IRQHandler,
+    PLL1_IRQHandler, USBActivity_IRQHandler, CANActivity_IRQHandler,
+    SysTick_Handler,
+};
+
+static int uart_line(int u){
+    uart_m *m = &uart[u];
+    uint32_t ier = sim_uart[u].IER;
+    return ((ier & 1) && m->rxn) || ((ier & 2) && m->thre);
+}
+
+static int irq_line(int i){
+    switch(i){
+        case TIMER0_IRQn: case TIMER1_IRQn: case TIMER2_IRQn: case TIMER3_IRQn:
+            return ctr[i - TIMER0_IRQn].ir != 0;
+        case PWM1_IRQn:  return ctr[4].ir != 0;
+        case UART0_IRQn: case UART1_IRQn: case UART2_IRQn: case UART3_IRQn:
+            return uart_line(i - UART0_IRQn);
+        case I2C2_IRQn:  return (i2c.con & I2C_SI) != 0;
+        case EINT3_IRQn: return (intStatR[0] | intStatF[0] | intStatR[1] | intStatF[1]) != 0;
+        case ADC_IRQn: {
+            uint32_t done = 0, n;
+            for(n = 0; n < 8; n++) if(adc.dr[n] & (1u << 31)) done |= 1u << n;
+            return (done & sim_adc.ADINTEN & 0xFF) || ((sim_adc.ADINTEN & 0x100) && (adc.gdr & (1u << 31)));
+        }
+        case DMA_IRQn:   return (dmaTC | dmaErr) != 0;
+        case SYSTICK_X:  return sysPend;
+    }
+    return 0;
+}
+
+static void commit(int p);
+static void bb_commit(void);
+
+static int pick(void){
+    int i, best = -1;
+    for(i = 0; i <= NIRQ; i++){
+        if(!nvActive[i] && irq_line(i)) nvPend[i] = 1;   // level: re-pends after return
+        if(nvPend[i] && (nvEn[i] || i == SYSTICK_X) && !nvActive[i] && nvPrio[i] < curPrio
+           && (best < 0 || nvPrio[i] < nvPrio[best]))
+            best = i;
+    }
+    return best;
+}
+
+/* Take every interrupt that can preempt what runs now. Handlers run as
+   plain calls; their own accesses come back in here for nesting. */
+static void dispatch(void){
+    int chained = 0;
+    while(!primask){
+        int i = pick(), saved;
+        if(i < 0) break;
+        advance(chained ? SIM_CHAIN : SIM_STACK);
+        nvPend[i] = 0;
+        if(i == SYSTICK_X) sysPend = 0;
+        nvActive[i] = 1;
+        saved = curPrio;
+        curPrio = nvPrio[i];
+        inCore = 0;
+        vectors[i]();
+        inCore = 1;
+        commit(lastPeriph);
+        lastPeriph = -1;
+        nvActive[i] = 0;
+        curPrio = saved;
+        chained = 1;
+        if(pick() < 0 || primask){ advance(SIM_STACK); break; }
+    }
+}
+
+/* ---------- Register blocks: writes, read side effects, read values ---------- */
+static struct {
+    void *regs;
+    unsigned int words, cost;
+    uint32_t shadow[128];
+} blk[SIM_NPERIPH];
+#define SIM_BB SIM_NPERIPH          // lastPeriph: a bit-band alias store
+
+static void wr_sc(unsigned int w, uint32_t v){
+    int i;
+    if(w == W(LPC_SC_TypeDef, CCLKCFG))
+        cclk = PLL0_HZ / ((v & 0xFF) + 1);
+    else if(w == W(LPC_SC_TypeDef, PCLKSEL0) || w == W(LPC_SC_TypeDef, PCLKSEL1))
+        for(i = 0; i < 5; i++){ ctr_rebase(i); ctr_next(&ctr[i]); }   // TC so far at the old tick
+}
+
+static void wr_gpio(int port, unsigned int w, uint32_t v){
+    LPC_GPIO_TypeDef *r = &sim_gpio[port];
+    uint32_t mask = r->FIOMASK;
+    if(w == W(LPC_GPIO_TypeDef, FIOSET))      gpio_output(port, gpioOut[port] | (v & ~mask));
+    else if(w == W(LPC_GPIO_TypeDef, FIOCLR)) gpio_output(port, gpioOut[port] & ~(v & ~mask));
+    else if(w == W(LPC_GPIO_TypeDef, FIOPIN)) gpio_output(port, (gpioOut[port] & mask) | (v & ~mask));
+}
+
+static void wr_gpioint(unsigned int w, uint32_t v){
+    if(w == W(LPC_GPIOINT_TypeDef, IO0IntClr)){ intStatR[0] &= ~v; intStatF[0] &= ~v; }
+    else if(w == W(LPC_GPIOINT_TypeDef, IO2IntClr)){ intStatR[1] &= ~v; intStatF[1] &= ~v; }
+    else if(w == W(LPC_GPIOINT_TypeDef, IO0IntEnR)) intEnR[0] = v;
+    else if(w == W(LPC_GPIOINT_TypeDef, IO0IntEnF)) intEnF[0] = v;
+    else if(w == W(LPC_GPIOINT_TypeDef, IO2IntEnR)) intEnR[1] = v;
+    else if(w == W(LPC_GPIOINT_TypeDef, IO2IntEnF)) intEnF[1] = v;
+}
+
+static void wr_ctr(int i, unsigned int w, uint32_t v){
+    counter *c = &ctr[i];
+    switch(w){
+        case W(LPC_TIM_TypeDef, IR):  c->ir &= ~v; return;
+        case W(LPC_TIM_TypeDef, TCR):
+            if(v & 2){ c->running = 0; c->tcBase = 0; }
+            else if((v & 1) && !c->running){ c->running = 1; c->base = now; c->from = now; c->tick = ctr_tick(i); }
+            else if(!(v & 1) && c->running){ c->tcBase = ctr_tc(c, now); c->running = 0; }
+            break;
+        case W(LPC_TIM_TypeDef, TC):  c->tcBase = v; c->base = now; c->from = now; break;
+        case W(LPC_TIM_TypeDef, PR):  c->pr = v; ctr_rebase(i); break;
+        case W(LPC_TIM_TypeDef, MCR): c->mcr = v; break;
+        case W(LPC_TIM_TypeDef, MR0): case W(LPC_TIM_TypeDef, MR1):
+        case W(LPC_TIM_TypeDef, MR2): case W(LPC_TIM_TypeDef, MR3):
+            c->mr[w - W(LPC_TIM_TypeDef, MR0)] = v; break;
+        case W(LPC_TIM_TypeDef, CCR): c->ccr = v; break;
+        default:
+            if(!c->pwm && w == W(LPC_TIM_TypeDef, EMR)){
+                uint32_t old = c->em, n;
+                c->emr = v;
+                c->em = v & 0xF;
+                for(n = 0; n < 4; n++)
+                    if(((old ^ c->em) >> n) & 1) pin_event(i, n, (c->em >> n) & 1);
+            }
+            else if(c->pwm && w >= W(LPC_PWM_TypeDef, MR4) && w <= W(LPC_PWM_TypeDef, MR6))
+                c->mr[4 + w - W(LPC_PWM_TypeDef, MR4)] = v;
+            else if(c->pwm && w == W(LPC_PWM_TypeDef, PCR)) c->pcr = v;
+            break;
+    }
+    ctr_next(c);
+}
+
+static void wr_adc(unsigned int w, uint32_t v){
+    uint32_t old = blk[SIM_ADC].shadow[w];
+    if(w != W(LPC_ADC_TypeDef, ADCR)) return;
+    if(!(v & (1 << 21))){ adc.ch = -1; adc.done = NEVER; return; }
+    if((v & (1 << 16)) && (!(old & (1 << 16)) || adc.ch < 0)){
+        if(adc.ch < 0 && adc_first(7) >= 0) adc_start(adc_first(7));
+    }
+    else if(!(v & (1 << 16)) && (old & (1 << 16))){ adc.ch = -1; adc.done = NEVER; }
+    if(((v >> 24) & 7) == 1 && adc.ch < 0 && adc_first(7) >= 0) adc_start(adc_first(7));
+}
+
+static void wr_uart(int u, unsigned int w, uint32_t v){
+    uart_m *m = &uart[u];
+    if(w == W(LPC_UART_TypeDef, THR)){
+        if(m->txn < 16) m->tx[m->txn++] = v & 0xFF;
+        m->thre = 0;
+        if(!m->shifting) uart_shift(u);
+    }
+    else if(w == W(LPC_UART_TypeDef, FCR)){
+        if(v & 2) m->rxn = 0;
+        if(v & 4) m->txn = 0;
+    }
+}
+
+static void wr_i2c(unsigned int w, uint32_t v){
+    if(w == W(LPC_I2C_TypeDef, I2CONSET)){
+        i2c.con |= v & 0x7C;
+        i2c_kick();
+    }
+    else if(w == W(LPC_I2C_TypeDef, I2CONCLR)){
+        int si = (v & I2C_SI) && (i2c.con & I2C_SI);
+        i2c.con &= ~(v & 0x6C);
+        if(si && i2c.inTx){                       // SI cleared: do what is set
+            if(i2c.con & I2C_STO) i2c_schedule(I2C_OP_STOP, 1);
+            else if(i2c.con & I2C_STA) i2c_schedule(I2C_OP_START, 1);
+            else i2c_schedule(I2C_OP_BYTE, 9);
+        }
+        else i2c_kick();
+    }
+    else if(w == W(LPC_I2C_TypeDef, I2DAT)) i2c.dat = v & 0xFF;
+}
+
+static void wr_gpdma(unsigned int w, uint32_t v){
+    if(w == W(LPC_GPDMA_TypeDef, DMACIntTCClear)) dmaTC &= ~v;
+    else if(w == W(LPC_GPDMA_TypeDef, DMACIntErrClr)) dmaErr &= ~v;
+}
+
+static void wr_systick(unsigned int w, uint32_t v){
+    if(w == W(SysTick_Type, VAL) || (w == W(SysTick_Type, CTRL) && (v & 1))){
+        sysBase = now;
+        sysNext = (sim_systick.CTRL & 1) ? now + (sim_systick.LOAD & 0xFFFFFF) + 1 : NEVER;
+    }
+    if(w == W(SysTick_Type, CTRL) && !(v & 1)) sysNext = NEVER;
+}
+
+static void wr_dwt(unsigned int w, uint32_t v){
+    if(w == W(DWT_Type, CYCCNT)){ cycBase = now - v; cycFrozen = v; }
+    else if(w == W(DWT_Type, CTRL)) cycBase = now - cycFrozen;
+}
+
+static void reg_write(int p, unsigned int w, uint32_t v){
+    switch(p){
+        case SIM_SC:      wr_sc(w, v); break;
+        case SIM_GPIO0: case SIM_GPIO1: case SIM_GPIO2: case SIM_GPIO3: case SIM_GPIO4:
+                          wr_gpio(p - SIM_GPIO0, w, v); break;
+        case SIM_GPIOINT: wr_gpioint(w, v); break;
+        case SIM_TIM0: case SIM_TIM1: case SIM_TIM2: case SIM_TIM3: case SIM_PWM1:
+                          wr_ctr(p - SIM_TIM0, w, v); break;
+        case SIM_ADC:     wr_adc(w, v); break;
+        case SIM_UART0: case SIM_UART1: case SIM_UART2: case SIM_UART3:
+                          wr_uart(p - SIM_UART0, w, v); break;
+        case SIM_I2C2:    wr_i2c(w, v); break;
+        case SIM_SSP0:    if(w == W(LPC_SSP_TypeDef, DR)){ ssp_push(v); if(sspBusy < now) sspBusy = now; sspBusy += ssp_byte(); } break;
+        case SIM_GPDMA:   wr_gpdma(w, v); break;
+        case SIM_GPDMACH0: case SIM_GPDMACH1:
+            if(w == W(LPC_GPDMACH_TypeDef, DMACCConfig)){
+                if(v & 1) dma_start(p - SIM_GPDMACH0);
+                else { dmaCh[p - SIM_GPDMACH0].active = 0; dmaCh[p - SIM_GPDMACH0].tcAt = NEVER; }
+            }
+            break;
+        case SIM_SYSTICK: wr_systick(w, v); break;
+        case SIM_DWT:     wr_dwt(w, v); break;
+    }
+}
+
+/* Side effects of reading: on the chip they follow the read of one
+   register; here any access to the block triggers them, at the next
+   access. Reading ADDRn / ADGDR clears DONE, RBR pops the RX FIFO, IIR
+   (or a THR write) clears the THRE interrupt. */
+static void read_effects(int p){
+    int n;
+    if(p == SIM_ADC){
+        for(n = 0; n < 8; n++) adc.dr[n] &= ~(3u << 30);
+        adc.gdr &= ~(3u << 30);
+    }
+    else if(p >= SIM_UART0 && p <= SIM_UART3){
+        uart_m *m = &uart[p - SIM_UART0];
+        m->thre = 0;
+        if(m->rxn) memmove(m->rx, m->rx + 1, --m->rxn);
+    }
+}
+
+static void commit(int p){
+    uint32_t *r, *s;
+    unsigned int w;
+    if(p < 0) return;
+    if(p == SIM_BB){ bb_commit(); return; }
+    read_effects(p);
+    r = (uint32_t *)blk[p].regs;
+    s = blk[p].shadow;
+    for(w = 0; w < blk[p].words; w++){
+        uint32_t v = ((volatile uint32_t *)r)[w];
+        if(v != s[w]){
+            reg_write(p, w, v);
+            s[w] = v;
+        }
+    }
+    recompute();
+}
+
+static void present(int p){
+    int i, n;
+    switch(p){
+        case SIM_SC:
+            sim_sc.PLL0STAT = (1u << 24) | (1u << 25) | (1u << 26);
+            sim_sc.PLL0FEED = sim_sc.PLL1FEED = SIM_WO;
+            break;
+        case SIM_GPIO0: case SIM_GPIO1: case SIM_GPIO2: case SIM_GPIO3: case SIM_GPIO4:
+            i = p - SIM_GPIO0;
+            sim_gpio[i].FIOPIN = gpio_pin(i) & ~sim_gpio[i].FIOMASK;
+            sim_gpio[i].FIOSET = sim_gpio[i].FIOCLR = SIM_WO;
+            break;
+        case SIM_GPIOINT:
+            sim_gpioint.IO0IntStatR = intStatR[0]; sim_gpioint.IO0IntStatF = intStatF[0];
+            sim_gpioint.IO2IntStatR = intStatR[1]; sim_gpioint.IO2IntStatF = intStatF[1];
+            sim_gpioint.IntStatus = ((intStatR[0] | intStatF[0]) ? 1 : 0) | ((intStatR[1] | intStatF[1]) ? 4 : 0);
+            sim_gpioint.IO0IntClr = sim_gpioint.IO2IntClr = SIM_WO;
+            break;
+        case SIM_TIM0: case SIM_TIM1: case SIM_TIM2: case SIM_TIM3: {
+            LPC_TIM_TypeDef *r = &sim_tim[p - SIM_TIM0];
+            counter *c = &ctr[p - SIM_TIM0];
+            r->IR = SIM_WO;
+            r->TC = ctr_tc(c, now);
+            r->CR0 = c->cr[0]; r->CR1 = c->cr[1];
+            r->EMR = (c->emr & ~0xFu) | c->em;
+            break;
+        }
+        case SIM_PWM1:
+            sim_pwm1.IR = SIM_WO;
+            sim_pwm1.TC = ctr_tc(&ctr[4], now);
+            break;
+        case SIM_ADC: {
+            uint32_t st = 0;
+            for(n = 0; n < 8; n++){
+                (&sim_adc.ADDR0)[n] = adc.dr[n];
+                if(adc.dr[n] & (1u << 31)) st |= 1u << n;
+                if(adc.dr[n] & (1u << 30)) st |= 1u << (8 + n);
+            }
+            if(st & sim_adc.ADINTEN & 0xFF) st |= 1u << 16;
+            sim_adc.ADGDR = adc.gdr;
+            sim_adc.ADSTAT = st;
+            break;
+        }
+        case SIM_UART0: case SIM_UART1: case SIM_UART2: case SIM_UART3: {
+            i = p - SIM_UART0;
+            LPC_UART_TypeDef *r = &sim_uart[i];
+            uart_m *m = &uart[i];
+            r->RBR = m->rxn ? m->rx[0] : 0;
+            r->LSR = (m->rxn ? 1 : 0) | (m->txn ? 0 : 0x20) | (m->txn || m->shifting ? 0 : 0x40);
+            r->IIR = 0xC0 | (((r->IER & 1) && m->rxn) ? 0x04 : ((r->IER & 2) && m->thre) ? 0x02 : 0x01);
+            r->THR = r->FCR = SIM_WO;
+            break;
+        }
+        case SIM_I2C2:
+            sim_i2c[2].I2CONSET = i2c.con;
+            sim_i2c[2].I2STAT = i2c.stat;
+            sim_i2c[2].I2DAT = i2c.dat;
+            sim_i2c[2].I2CONCLR = SIM_WO;
+            break;
+        case SIM_SSP0:
+            sim_ssp[0].SR = (sspBusy > now ? 0x10 : 0x01) | 0x02;
+            sim_ssp[0].DR = SIM_WO;
+            break;
+        case SIM_GPDMA:
+            sim_gpdma.DMACIntTCStat = sim_gpdma.DMACRawIntTCStat = dmaTC;
+            sim_gpdma.DMACIntErrStat = sim_gpdma.DMACRawIntErrStat = dmaErr;
+            sim_gpdma.DMACIntStat = dmaTC | dmaErr;
+            sim_gpdma.DMACEnbldChns = (dmaCh[0].active ? 1 : 0) | (dmaCh[1].active ? 2 : 0);
+            sim_gpdma.DMACIntTCClear = sim_gpdma.DMACIntErrClr = SIM_WO;
+            break;
+        case SIM_SYSTICK:
+            if(sysNext != NEVER)
+                sim_systick.VAL = (sim_systick.LOAD & 0xFFFFFF) - (uint32_t)((now - sysBase) % ((sim_systick.LOAD & 0xFFFFFF) + 1));
+            break;
+        case SIM_DWT:
+            if(dwt_on()) cycFrozen = (uint32_t)(now - cycBase);
+            sim_dwt.CYCCNT = cycFrozen;
+            break;
+    }
+    memcpy(blk[p].shadow, blk[p].regs, blk[p].words * 4);
+}
+
+/* ---------- Access hook ---------- */
+/* Bit-band alias (BITBAND_SRAM in Sim/LPC17xx.h). The address argument
+   was an access to the block already, which paid for the store; the
+   alias word is committed like a block of its own, as a read-modify-
+   write of the one register bit. */
+static struct { int p; unsigned int w, bit; uint32_t word, shadow; } bb;
+
+volatile uint32_t *sim_bitband(volatile void *reg, unsigned int bit){
+    int p;
+    inCore = 1;
+    for(p = 0; p < SIM_NPERIPH; p++)
+        if((char *)reg >= (char *)blk[p].regs && (char *)reg < (char *)blk[p].regs + blk[p].words * 4) break;
+    if(p == SIM_NPERIPH) finish("bit-band alias outside the peripherals");
+    commit(lastPeriph);
+    bb.p = p;
+    bb.w = (unsigned int)((char *)reg - (char *)blk[p].regs) / 4;
+    bb.bit = bit;
+    bb.word = bb.shadow = (blk[p].shadow[bb.w] >> bit) & 1;
+    lastPeriph = SIM_BB;
+    inCore = 0;
+    return &bb.word;
+}
+
+static void bb_commit(void){
+    uint32_t v;
+    if(bb.word == bb.shadow) return;
+    v = (blk[bb.p].shadow[bb.w] & ~(1u << bb.bit)) | ((bb.word & 1) << bb.bit);
+    reg_write(bb.p, bb.w, v);
+    blk[bb.p].shadow[bb.w] = v;
+    bb.shadow = bb.word;
+    recompute();
+}
+
+void *sim_access(int p){
+    inCore = 1;
+    entries++;
+    commit(lastPeriph);
+    lastPeriph = -1;
+    advance(blk[p].cost);
+    dispatch();
+    present(p);
+    lastPeriph = p;
+    inCore = 0;
+    return blk[p].regs;
+}
+
+static void core_op(uint64_t cycles, int irqs){
+    inCore = 1;
+    entries++;
+    commit(lastPeriph);
+    lastPeriph = -1;
+    advance(cycles);
+    if(irqs) dispatch();
+    inCore = 0;
+}
+
+/* Nothing to do until an interrupt: jump from event to event until one
+   can be taken (at most 10 ms of model time). Also what a CPU that made
+   no access for a whole profiling tick (2 ms of host time) gets: it can
+   only be polling RAM that an interrupt handler has to change. */
+static void idle(void){
+    uint64_t stop = now + (uint64_t)(cclk / 100);
+    while(primask || pick() < 0){
+        uint64_t t = nextEvt < stop ? nextEvt : stop;
+        if(t > now) advance(t - now); else { set_now(now); run_events(); }
+        if(now >= stop) break;
+    }
+}
+
+static void on_spin(int sig){
+    static unsigned long seen;
+    (void)sig;
+    if(inCore || entries != seen){ seen = entries; return; }   // not spinning
+    inCore = 1;
+    commit(lastPeriph);             // e.g. the START written just before the spin
+    lastPeriph = -1;
+    idle();
+    dispatch();
+    inCore = 0;
+}
+
+void __NOP(void){ core_op(1, 1); }
+void __DSB(void){ core_op(1, 1); }
+void __ISB(void){ core_op(1, 1); }
+void __disable_irq(void){ core_op(1, 0); primask = 1; }
+void __enable_irq(void){ primask = 0; core_op(1, 1); }
+void __WFI(void){
+    inCore = 1;
+    commit(lastPeriph);
+    lastPeriph = -1;
+    idle();
+    dispatch();
+    inCore = 0;
+}
+
+static int slot(IRQn_Type irq){ return irq == SysTick_IRQn ? SYSTICK_X : (int)irq; }
+
+void NVIC_EnableIRQ(IRQn_Type irq){ nvEn[slot(irq)] = 1; core_op(SIM_CORE, 1); }
+void NVIC_DisableIRQ(IRQn_Type irq){ nvEn[slot(irq)] = 0; core_op(SIM_CORE, 1); }
+void NVIC_SetPendingIRQ(IRQn_Type irq){ nvPend[slot(irq)] = 1; core_op(SIM_CORE, 1); }
+void NVIC_ClearPendingIRQ(IRQn_Type irq){ nvPend[slot(irq)] = 0; core_op(SIM_CORE, 1); }
+void NVIC_SetPriority(IRQn_Type irq, uint32_t prio){ nvPrio[slot(irq)] = prio & 31; core_op(SIM_CORE, 1); }
+uint32_t NVIC_GetPriority(IRQn_Type irq){ return nvPrio[slot(irq)]; }
+
+uint32_t SysTick_Config(uint32_t ticks){
+    SysTick->LOAD = ticks - 1;
+    NVIC_SetPriority(SysTick_IRQn, 31);
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_ENABLE_Msk;
+    return 0;
+}
+
+/* SystemInit() of the board: PLL0 400 MHz, CCLK 100 MHz, all PCLK = CCLK/4 */
+void SystemInit(void){
+    inCore = 1;
+    commit(lastPeriph);
+    lastPeriph = -1;
+    sim_sc.CCLKCFG = 3;
+    sim_sc.PCLKSEL0 = sim_sc.PCLKSEL1 = 0;
+    sim_sc.PCONP = 0x042887DE;
+    sim_sc.FLASHCFG = 0x303A;
+    memcpy(blk[SIM_SC].shadow, blk[SIM_SC].regs, blk[SIM_SC].words * 4);
+    cclk = PLL0_HZ / 4;
+    SystemCoreClock = 100000000;
+    inCore = 0;
+}
+
+void SystemCoreClockUpdate(void){
+    SystemCoreClock = (uint32_t)(PLL0_HZ / ((sim_sc.CCLKCFG & 0xFF) + 1));
+}
+
+/* ---------- Report ---------- */
+extern isr_stats __start_isr_stats[] __attribute__((weak));
+extern isr_stats __stop_isr_stats[] __attribute__((weak));
+
+static void finish(const char *why){
+    isr_stats *s;
+    char row[17];
+    static int done;
+
+    if(done) _exit(1);
+    done = 1;
+    if(uart[0].lineLen){ uart[0].line[uart[0].lineLen] = '\0'; printf("%s\n", uart[0].line); }
+    printf("--- sim: %s at %.6f s, CCLK %.0f MHz, %llu cycles\n", why, nowSec, cclk / 1e6,
+           (unsigned long long)now);
+    if(hd.used){
+        hd_row(0, row); printf("LCD  |%s|\n", row);
+        hd_row(1, row); printf("     |%s|\n", row);
+    }
+    if(i2c.bytes) printf("I2C2 %lu bytes to the PCF8574, %lu NACKs\n", i2c.bytes, i2c.nacks);
+    if(srLatches) printf("595  %u latches, last %02X %02X %02X %02X %02X\n", srLatches,
+                         srLatched[0], srLatched[1], srLatched[2], srLatched[3], srLatched[4]);
+
+    if((void *)__start_isr_stats != (void *)__stop_isr_stats)
+        printf("ISR statistics (model cycles; latency -, exit, histogram bin:count)\n");
+    for(s = __start_isr_stats; s && s < __stop_isr_stats; s++){
+        unsigned int b;
+        printf("  %-18s n=%-7u", s->name, s->count);
+        if(!s->count){ printf("\n"); continue; }
+        if(s->lat_min != 0xFFFFFFFF)
+            printf(" lat=%u..%u mean=%u", s->lat_min, s->lat_max, s->lat_sum / s->count);
+        printf(" exit=%u..%u\n    hist", s->exit_min, s->exit_max);
+        for(b = 0; b <= ISR_HIST_BINS; b++)
+            if(s->hist[b]) printf(" %u%s:%u", b << ISR_HIST_SHIFT, b == ISR_HIST_BINS ? "+" : "", s->hist[b]);
+        printf("\n");
+    }
+    fflush(stdout);
+    if(uart3File) fclose(uart3File);
+    _exit(0);
+}
+
+int main(int argc, char **argv){
+    struct sigaction sa;
+    struct itimerval it = { { 0, 2000 }, { 0, 2000 } };
+    int i;
+
+    for(i = 1; i < argc; i++){
+        if(!strcmp(argv[i], "-t") && i + 1 < argc) limitSec = atof(argv[++i]);
+        else if(!strcmp(argv[i], "-b") && i + 1 < argc) breakSec = atof(argv[++i]);
+        else if(!strcmp(argv[i], "-s") && i + 1 < argc) swSec = atof(argv[++i]);
+        else if(!strcmp(argv[i], "-l") && i + 1 < argc) lcdD4 = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "-u") && i + 1 < argc){
+            if(!(uart3File = fopen(argv[++i], "wb"))){ perror(argv[i]); return 2; }
+        }
+        else if(!strcmp(argv[i], "-d")) diffIn = 1;
+        else if(!strcmp(argv[i], "-v")) verbose = 1;
+        else{
+            fprintf(stderr, "usage: %s [-t seconds] [-b break_s] [-s sw1_s] [-l d4_pin] [-u file] [-d] [-v]\n", argv[0]);
+            return 2;
+        }
+    }
+
+#define BLK(id, var, c) blk[id].regs = (void *)&(var), blk[id].words = sizeof(var) / 4, blk[id].cost = (c)
+    BLK(SIM_SC, sim_sc, SIM_APB);           BLK(SIM_PINCON, sim_pincon, SIM_APB);
+    for(i = 0; i < 5; i++) BLK(SIM_GPIO0 + i, sim_gpio[i], SIM_AHB);
+    BLK(SIM_GPIOINT, sim_gpioint, SIM_APB);
+    for(i = 0; i < 4; i++) BLK(SIM_TIM0 + i, sim_tim[i], SIM_APB);
+    BLK(SIM_PWM1, sim_pwm1, SIM_APB);       BLK(SIM_ADC, sim_adc, SIM_APB);
+    BLK(SIM_DAC, sim_dac, SIM_APB);
+    for(i = 0; i < 4; i++) BLK(SIM_UART0 + i, sim_uart[i], SIM_APB);
+    for(i = 0; i < 3; i++) BLK(SIM_I2C0 + i, sim_i2c[i], SIM_APB);
+    for(i = 0; i < 2; i++) BLK(SIM_SSP0 + i, sim_ssp[i], SIM_APB);
+    BLK(SIM_GPDMA, sim_gpdma, SIM_AHB);
+    for(i = 0; i < 2; i++) BLK(SIM_GPDMACH0 + i, sim_gpdmach[i], SIM_AHB);
+    BLK(SIM_WDT, sim_wdt, SIM_APB);         BLK(SIM_SYSTICK, sim_systick, SIM_CORE);
+    BLK(SIM_DWT, sim_dwt, SIM_CORE);        BLK(SIM_COREDEBUG, sim_coredebug, SIM_CORE);
+    BLK(SIM_SCB, sim_scb, SIM_CORE);
+
+    for(i = 0; i < 5; i++){ ctr[i].pwm = (i == 4); ctr[i].tick = 4; ctr[i].next = NEVER; }
+    sim_uart[0].LCR = sim_uart[1].LCR = sim_uart[2].LCR = sim_uart[3].LCR = 0x03;
+    sim_i2c[2].I2SCLH = sim_i2c[2].I2SCLL = 4;
+    memset(hd.ddram, ' ', sizeof(hd.ddram));
+    for(i = 0; i < SIM_NPERIPH; i++) present(i);
+
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = on_spin;
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGPROF, &sa, NULL);
+    setitimer(ITIMER_PROF, &it, NULL);
+
+    app_main();
+    finish("main returned");
+    return 0;
+}
@@ -0,0 +1,69 @@
+/* ---------- Wavetable generator (host) ----------
+   Writes tone_tables.h for SILENT_INTRUDER_ALERT.c. Every table is one
+   block of TONE_BLOCK samples holding a whole number of cycles, so any
+   table can follow any other (or itself) in a DMA chain without a click.
+   With TONE_FS 16 kHz and 128 samples a block is 8 ms and the available
+   frequencies are multiples of 125 Hz.
+   Entries are ready-made DACR words (10-bit value in bits 15:6).
+
+   Build + run : gcc -O2 -std=c99 -o gen_tones Tone/gen_tones.c -lm
+                 ./gen_tones > tone_tables.h
+-------------------------------------------------*/
+#include <stdio.h>
+#include <math.h>
+
+#define TONE_FS    16000
+#define TONE_BLOCK 128
+#define DAC_MID    512
+#define DAC_AMP    480              // peak, leaves headroom at 0 and 1023
+#define TWO_PI     6.283185307179586
+
+/* name, cycles per block of up to two partials (0 = unused) */
+static const struct { const char *name; int k1, k2; } tables[] = {
+    { "TONE_T_SILENCE", 0,  0 },
+    { "TONE_T_625",     5,  0 },    // siren sweep 625 .. 1375 Hz
+    { "TONE_T_750",     6,  0 },
+    { "TONE_T_875",     7,  0 },
+    { "TONE_T_1000",    8,  0 },
+    { "TONE_T_1125",    9,  0 },
+    { "TONE_T_1250",   10,  0 },
+    { "TONE_T_1375",   11,  0 },
+    { "TONE_T_2000",   16,  0 },    // chirp
+    { "TONE_T_2500",   20,  0 },
+    { "TONE_T_3000",   24,  0 },
+    { "TONE_T_DUAL_A",  6,  9 },    // 750 + 1125 Hz
+    { "TONE_T_DUAL_B",  7, 11 },    // 875 + 1375 Hz
+};
+#define NTABLES (int)(sizeof(tables) / sizeof(tables[0]))
+
+int main(void){
+    int t, n;
+
+    printf("/* Generated by Tone/gen_tones.c - do not edit, regenerate instead */\n");
+    printf("#ifndef TONE_TABLES_H\n#define TONE_TABLES_H\n\n#include <stdint.h>\n\n");
+    printf("#define TONE_FS     %d\n", TONE_FS);
+    printf("#define TONE_BLOCK  %d          // samples per table (%d ms)\n",
+           TONE_BLOCK, TONE_BLOCK * 1000 / TONE_FS);
+    printf("#define TONE_TABLES %d\n\n", NTABLES);
+    for(t = 0; t < NTABLES; t++) printf("#define %-14s %d\n", tables[t].name, t);
+
+    printf("\n/* In SRAM (not const) so GPDMA reads them without touching flash */\n");
+    printf("uint32_t toneTable[TONE_TABLES][TONE_BLOCK] = {\n");
+    for(t = 0; t < NTABLES; t++){
+        printf("    { /* %s */", tables[t].name);
+        for(n = 0; n < TONE_BLOCK; n++){
+            double ph = TWO_PI * n / TONE_BLOCK, v;
+            int d;
+
+            if(tables[t].k2)
+                v = 0.5 * sin(tables[t].k1 * ph) + 0.5 * sin(tables[t].k2 * ph);
+            else
+                v = tables[t].k1 ? sin(tables[t].k1 * ph) : 0.0;
+            d = DAC_MID + (int)lround(DAC_AMP * v);
+            printf("%s0x%04X%s", n % 8 ? " " : "\n        ", d << 6, n < TONE_BLOCK - 1 ? "," : "");
+        }
+        printf("\n    }%s\n", t < NTABLES - 1 ? "," : "");
+    }
+    printf("};\n\n#endif\n");
+    return 0;
+}
@@ -0,0 +1,219 @@
+/* ---------- Zone trace replay (host) ----------
+   Feeds a trace recorded by SILENT_INTRUDER_ALERT.c (TRACE_ENABLE 1, zone
+   mode) or synthesised here through the same zone_scan() / status-line
+   code the board runs, as fast as the PC allows.
+
+   Build : gcc -O2 -std=c99 -o replay Trace/replay.c
+   Use   : replay [-q] [-r N] [-l lo] [-h hi] [-n trip] file.trc
+           replay -g hours [-s seed] file.trc     (write a synthetic trace)
+
+   Prints every alarm decision (scan number, latched / broken masks, LCD
+   status row), then records/s, samples/s and a decision digest. Two runs
+   with the same digest made the same decisions at the same scans.
+-----------------------------------------------*/
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../zone_logic.h"
+
+#define LCD_COLS   16
+#define ADC_CLK_HZ 5000000           // synthetic traces: board's ADC clock
+
+typedef struct {
+    uint8_t  mask, decim;
+    uint16_t trip, lo, hi, scanHz;
+} trace_hdr;
+
+static uint16_t rd16(const uint8_t *p){ return p[0] | (p[1] << 8); }
+static uint32_t rd32(const uint8_t *p){ return rd16(p) | ((uint32_t)rd16(p + 2) << 16); }
+
+static int check_sum(const uint8_t *p, unsigned int len){
+    uint8_t sum = 0;
+    unsigned int n;
+    for(n = 0; n < len - 1; n++) sum ^= p[n];
+    return sum == p[len - 1];
+}
+
+static void put_rec(FILE *f, uint8_t *rec, unsigned int len){
+    uint8_t sum = 0;
+    unsigned int n;
+    for(n = 0; n < len - 1; n++) sum ^= rec[n];
+    rec[len - 1] = sum;
+    fwrite(rec, 1, len, f);
+}
+
+/* ---------- Synthetic trace ----------
+   Beam levels around 3900 counts with +-40 noise, random breaks of
+   50 ms .. 2 s on random zones, SW1 held for 200 ms a few seconds later.
+   xorshift32 keeps it reproducible for a given seed.
+--------------------------------------*/
+static uint32_t rng;
+static uint32_t rnd(void){ rng ^= rng << 13; rng ^= rng >> 17; rng ^= rng << 5; return rng; }
+
+static int synth(const char *path, double hours, uint32_t seed){
+    const trace_hdr h = { 0xFF, 32, 2, 3650, 3750, zone_scan_hz(ADC_CLK_HZ, 0xFF) };
+    uint32_t rate = h.scanHz / h.decim, total = (uint32_t)(hours * 3600.0 * rate), i;
+    uint32_t breakEnd[ZONE_COUNT] = { 0 }, swFrom = 0, swTo = 0;
+    uint8_t rec[TRACE_SCAN_LEN], hdr[TRACE_HDR_LEN];
+    unsigned int z;
+    FILE *f = fopen(path, "wb");
+
+    if(!f){ perror(path); return 1; }
+    rng = seed ? seed : 1;
+
+    hdr[0] = TRACE_HDR; hdr[1] = h.mask;
+    hdr[2] = h.trip & 0xFF; hdr[3] = h.trip >> 8;
+    hdr[4] = h.lo & 0xFF;   hdr[5] = h.lo >> 8;
+    hdr[6] = h.hi & 0xFF;   hdr[7] = h.hi >> 8;
+    hdr[8] = h.decim;
+    hdr[9] = h.scanHz & 0xFF; hdr[10] = h.scanHz >> 8;
+    put_rec(f, hdr, TRACE_HDR_LEN);
+
+    for(i = 1; i <= total; i++){
+        uint32_t seq = i * h.decim;
+
+        if(i % TRACE_HDR_EVERY == 0) put_rec(f, hdr, TRACE_HDR_LEN);   // as the board does
+
+        if(rnd() % (rate * 30) == 0){            // ~one break per 30 s
+            z = rnd() % ZONE_COUNT;
+            breakEnd[z] = i + rate / 20 + rnd() % (2 * rate);
+            swFrom = breakEnd[z] + rate * (1 + rnd() % 5);
+            swTo   = swFrom + rate / 5;
+        }
+
+        rec[0] = TRACE_SCAN;
+        rec[1] = seq; rec[2] = seq >> 8; rec[3] = seq >> 16; rec[4] = seq >> 24;
+        rec[5] = (i >= swFrom && i < swTo) ? TRACE_IN_SW1 : 0;
+        for(z = 0; z < ZONE_COUNT; z++){
+            uint16_t x = (i < breakEnd[z] ? 600 : 3900) + rnd() % 81 - 40;
+            rec[6 + 2 * z] = x & 0xFF;
+            rec[7 + 2 * z] = x >> 8;
+        }
+        put_rec(f, rec, TRACE_SCAN_LEN);
+    }
+    fclose(f);
+    printf("%u records (%.1f h at %u scans/s)\n", total, hours, rate);
+    return 0;
+}
+
+/* ---------- Replay ---------- */
+static uint8_t *load(const char *path, long *len){
+    FILE *f = fopen(path, "rb");
+    uint8_t *buf;
+
+    if(!f){ perror(path); return NULL; }
+    fseek(f, 0, SEEK_END);
+    *len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    buf = malloc(*len ? *len : 1);
+    if(!buf || fread(buf, 1, *len, f) != (size_t)*len){ fclose(f); free(buf); return NULL; }
+    fclose(f);
+    return buf;
+}
+
+int main(int argc, char **argv){
+    int quiet = 0, reps = 1, r, i;
+    long len = 0, pos;
+    int lo = -1, hi = -1, trip = -1;
+    double genHours = 0;
+    uint32_t seed = 1;
+    const char *path = NULL;
+    uint8_t *buf;
+    trace_hdr h = { 0xFF, 1, 48, 3650, 3750, 0 };
+    uint64_t records = 0, events = 0, bad = 0, gaps = 0, early = 0;
+    uint32_t digest = 2166136261u;
+    struct timespec t0, t1;
+    double secs;
+
+    for(i = 1; i < argc; i++){
+        if(!strcmp(argv[i], "-q")) quiet = 1;
+        else if(!strcmp(argv[i], "-r") && i + 1 < argc) reps = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "-l") && i + 1 < argc) lo = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "-h") && i + 1 < argc) hi = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "-n") && i + 1 < argc) trip = atoi(argv[++i]);
+        else if(!strcmp(argv[i], "-g") && i + 1 < argc) genHours = atof(argv[++i]);
+        else if(!strcmp(argv[i], "-s") && i + 1 < argc) seed = strtoul(argv[++i], NULL, 0);
+        else path = argv[i];
+    }
+    if(!path){
+        fprintf(stderr, "usage: replay [-q] [-r N] [-l lo] [-h hi] [-n trip] file.trc\n"
+                        "       replay -g hours [-s seed] file.trc\n");
+        return 2;
+    }
+    if(genHours > 0) return synth(path, genHours, seed);
+    if(!(buf = load(path, &len))) return 1;
+
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for(r = 0; r < reps; r++){
+        uint16_t zLo[ZONE_COUNT], zHi[ZONE_COUNT], zRun[ZONE_COUNT] = { 0 }, x[ZONE_COUNT];
+        uint8_t broken = 0, alarm = 0, shownA = 0, shownB = 0, haveHdr = 0;
+        uint32_t seq, lastSeq = 0;
+        char line[LCD_COLS + 1];
+        unsigned int z;
+
+        for(z = 0; z < ZONE_COUNT; z++){ zLo[z] = h.lo; zHi[z] = h.hi; }
+
+        for(pos = 0; pos < len; ){
+            if(buf[pos] == TRACE_HDR && pos + TRACE_HDR_LEN <= len && check_sum(buf + pos, TRACE_HDR_LEN)){
+                const uint8_t *p = buf + pos;
+                h.mask = p[1]; h.trip = rd16(p + 2); h.lo = rd16(p + 4); h.hi = rd16(p + 6); h.decim = p[8];
+                h.scanHz = rd16(p + 9);
+                if(lo >= 0) h.lo = lo;
+                if(hi >= 0) h.hi = hi;
+                if(trip > 0) h.trip = trip;
+                for(z = 0; z < ZONE_COUNT; z++){ zLo[z] = h.lo; zHi[z] = h.hi; }
+                haveHdr = 1;
+                pos += TRACE_HDR_LEN;
+                continue;
+            }
+            if(buf[pos] != TRACE_SCAN || pos + TRACE_SCAN_LEN > len || !check_sum(buf + pos, TRACE_SCAN_LEN)){
+                bad++;                                   // resync on the next byte
+                pos++;
+                continue;
+            }
+
+            if(!haveHdr){                                // joined mid-stream: mask / decim
+                early++;                                 // unknown until the next 'H'
+                pos += TRACE_SCAN_LEN;
+                continue;
+            }
+            seq = rd32(buf + pos + 1);
+            if(lastSeq && seq != lastSeq + h.decim) gaps++;
+            lastSeq = seq;
+            for(z = 0; z < ZONE_COUNT; z++) x[z] = rd16(buf + pos + 6 + 2 * z);
+
+            /* same order as the board's ADC_IRQHandler */
+            alarm |= zone_scan(h.mask, h.trip, x, zLo, zHi, zRun, &broken);
+            if(buf[pos + 5] & TRACE_IN_SW1) alarm &= broken;
+            records++;
+
+            if(alarm != shownA || broken != shownB){
+                zone_status_line(line, LCD_COLS, h.mask, broken, alarm);
+                if(r == 0){                              // log + digest first pass only
+                    if(!quiet)
+                        printf("scan %10u  t=%9.3fs  alarm=%02X broken=%02X  %s\n",
+                               seq, h.scanHz ? (double)seq / h.scanHz : 0.0, alarm, broken, line);
+                    digest = (digest ^ seq) * 16777619u;
+                    digest = (digest ^ ((alarm << 8) | broken)) * 16777619u;
+                    events++;
+                }
+                shownA = alarm; shownB = broken;
+            }
+            pos += TRACE_SCAN_LEN;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    secs = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+
+    printf("records   %llu (%d pass%s), %llu bad bytes, %llu gaps\n",
+           (unsigned long long)records, reps, reps > 1 ? "es" : "",
+           (unsigned long long)(bad / reps), (unsigned long long)(gaps / reps));
+    if(early) printf("skipped   %llu records before the first header\n", (unsigned long long)(early / reps));
+    printf("decisions %llu  digest %08X\n", (unsigned long long)events, digest);
+    printf("time      %.3f s  %.0f records/s  %.0f samples/s\n",
+           secs, records / secs, records * (double)__builtin_popcount(h.mask) / secs);
+    free(buf);
+    return 0;
+}
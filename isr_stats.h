@@ -0,0 +1,88 @@
+/* ---------- Per-source ISR statistics ----------
+   The DWT entry / exit counters and latency histogram of ISR_BENCH.c,
+   shared by the application ISRs (TIMER2 capture, I2C2 LCD, UART3 trace,
+   GPDMA '595 latch, ADC beam ISRs) and by the host simulator in Sim/,
+   which prints every table it finds. On the board, watch the isr_stats
+   variables in the debugger. Include after LPC17xx.h; ISR_STATS 0
+   compiles all of it out.
+     latency : hardware event -> first ISR instruction, for sources that
+               timestamp the event (capture / match registers), else
+               ISR_LAT_NONE
+     exit    : first ISR instruction -> last instruction
+     hist    : latency, or exit cycles when there is no latency
+--------------------------------------------------*/
+#ifndef ISR_STATS_H
+#define ISR_STATS_H
+
+#include <stdint.h>
+
+#ifndef ISR_STATS
+#define ISR_STATS      1
+#endif
+#ifndef ISR_HIST_SHIFT
+#define ISR_HIST_SHIFT 4            // 16-cycle bins
+#endif
+#ifndef ISR_HIST_BINS
+#define ISR_HIST_BINS  64           // + 1 overflow bin
+#endif
+#define ISR_LAT_NONE   0xFFFFFFFFu
+
+/* The host simulator collects the tables from a named section */
+#ifndef ISR_STATS_SECTION
+#define ISR_STATS_SECTION
+#endif
+
+typedef struct {
+    const char *name;
+    uint32_t count;
+    uint32_t lat_min, lat_max, lat_sum;
+    uint32_t exit_min, exit_max;
+    uint32_t hist[ISR_HIST_BINS + 1];     // 32-bit: the app ISRs run for hours
+} isr_stats;
+
+static inline void isr_stats_reset(isr_stats *s){
+    unsigned int b;
+    s->count = 0;
+    s->lat_min = s->exit_min = 0xFFFFFFFF;
+    s->lat_max = s->exit_max = s->lat_sum = 0;
+    for(b = 0; b <= ISR_HIST_BINS; b++) s->hist[b] = 0;
+}
+
+#if ISR_STATS
+// Cycle counter on (idempotent)
+static inline void isr_stats_start(void){
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/* Last statement of the ISR. t0 = DWT->CYCCNT on entry. Always inlined:
+   several of the ISRs run from SRAM and must not call into flash. */
+static inline __attribute__((always_inline))
+void isr_stats_record(isr_stats *s, uint32_t lat, uint32_t t0){
+    uint32_t ex = DWT->CYCCNT - t0, h = ex;
+
+    s->count++;
+    if(lat != ISR_LAT_NONE){
+        s->lat_sum += lat;
+        if(lat < s->lat_min) s->lat_min = lat;
+        if(lat > s->lat_max) s->lat_max = lat;
+        h = lat;
+    }
+    if(ex < s->exit_min) s->exit_min = ex;
+    if(ex > s->exit_max) s->exit_max = ex;
+    h >>= ISR_HIST_SHIFT;
+    s->hist[h < ISR_HIST_BINS ? h : ISR_HIST_BINS]++;
+}
+
+#define ISR_STATS_DEF(var, label) \
+    ISR_STATS_SECTION isr_stats var = { label, 0, 0xFFFFFFFF, 0, 0, 0xFFFFFFFF, 0, { 0 } }
+#define ISR_ENTRY(t0)           uint32_t t0 = DWT->CYCCNT
+#define ISR_EXIT(var, lat, t0)  isr_stats_record(&(var), (lat), (t0))
+#else
+static inline void isr_stats_start(void){ }
+#define ISR_STATS_DEF(var, label) extern isr_stats var
+#define ISR_ENTRY(t0)           do { } while(0)
+#define ISR_EXIT(var, lat, t0)  do { } while(0)
+#endif
+
+#endif
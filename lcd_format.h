@@ -0,0 +1,63 @@
+/* ---------- Bounded LCD row formatter ----------
+   printf subset for one display row: %u %d %x with an optional width, and
+   %.Nu / %.Nd fixed-decimal (argument in units of 10^-N). Fields are
+   right-aligned, output stops at LCD_COLS and the row is space-padded, so
+   line needs LCD_COLS + 1 bytes. A format that ends inside a conversion
+   ("%", "%5") stops there without fetching an argument.
+   Replaces sprintf: no heap, no float, no newlib printf; stack use is a
+   12-byte digit buffer. Included after LCD_COLS by ADC & LCD.c,
+   CAPTURE & LCD.c and SILENT_INTRUDER_ALERT.c, and by the host check in
+   Lcd/format_bench.c.
+-------------------------------------------------*/
+#ifndef LCD_FORMAT_H
+#define LCD_FORMAT_H
+
+#include <stdarg.h>
+
+void lcd_format(char *line, const char *fmt, ...){
+    va_list ap;
+    char num[12];
+    unsigned int pos = 0, width, prec, n, v;
+    int s, neg;
+
+    va_start(ap, fmt);
+    while(*fmt && pos < LCD_COLS){
+        if(*fmt != '%' || *++fmt == '%'){ line[pos++] = *fmt++; continue; }
+
+        width = prec = 0;
+        while(*fmt >= '0' && *fmt <= '9') width = width * 10 + (*fmt++ - '0');
+        if(*fmt == '.' && fmt[1] >= '0' && fmt[1] <= '9'){ prec = fmt[1] - '0'; fmt += 2; }
+        if(*fmt == '\0') break;                 // no conversion: no argument
+
+        neg = 0;
+        if(*fmt == 'd'){
+            s = va_arg(ap, int);
+            neg = (s < 0);
+            v = neg ? 0U - (unsigned int)s : (unsigned int)s;
+        }
+        else v = va_arg(ap, unsigned int);
+
+        n = 0;                                   // digits built backwards
+        if(*fmt == 'x'){
+            do { num[n++] = "0123456789ABCDEF"[v & 0xF]; v >>= 4; } while(v);
+        }
+        else{
+            do {
+                num[n++] = '0' + (v % 10);
+                v /= 10;
+                if(n == prec) num[n++] = '.';
+            } while(v || (prec && n <= prec + 1));
+        }
+        if(neg) num[n++] = '-';
+        fmt++;
+
+        while(width > n && pos < LCD_COLS){ line[pos++] = ' '; width--; }
+        while(n && pos < LCD_COLS) line[pos++] = num[--n];
+    }
+    va_end(ap);
+
+    while(pos < LCD_COLS) line[pos++] = ' ';     // overwrite rest of the row
+    line[pos] = '\0';
+}
+
+#endif
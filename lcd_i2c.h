@@ -0,0 +1,153 @@
+/* lcd_i2c.h - HD44780 over a PCF8574 backpack on I2C2, interrupt driven.
+   Included by SILENT_INTRUDER_ALERT.c (LCD_TRANSPORT_I2C 1) after its
+   LPC17xx.h, PCF8574_ADDR, I2C_RATE_HZ and I2C_QLEN, and by the host
+   model in Lcd/, which supplies fake registers instead. */
+#ifndef LCD_I2C_H
+#define LCD_I2C_H
+
+#include <stdint.h>
+#include "isr_stats.h"
+
+/* Busy-wait body. Empty on the board, where I2C2_IRQHandler drains the
+   queue; the host model steps its emulated bus here. */
+#ifndef I2C_WAIT
+#define I2C_WAIT()
+#endif
+
+/* Microsecond wait for the HD44780 power-on sequence, on the DWT cycle
+   counter (a loop count would change with CCLK and the compiler). The
+   host model advances its clock instead. */
+#ifndef LCD_DELAY_US
+static void lcd_delay_us(uint32_t us){
+    uint32_t t0, n = us * (SystemCoreClock / 1000000);
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    t0 = DWT->CYCCNT;
+    while(DWT->CYCCNT - t0 < n);
+}
+#define LCD_DELAY_US(us) lcd_delay_us(us)
+#endif
+
+/* ---------- LCD helpers (I2C transport) ----------
+   Every HD44780 nibble becomes two PCF8574 bytes (EN high, EN low), so one
+   LCD byte is 4 I2C bytes (~90 us at 400 kHz, longer than the 37 us the
+   LCD needs). lcd_cmd()/lcd_data() only append to i2cQ; the I2C2
+   interrupt streams the queue as one long write transaction and sends
+   STOP when it runs dry. A full 16-character row (68 bytes) is queued
+   without waiting; the CPU only waits if the queue is full.
+   Slow commands (clear/home, 1.52 ms) are followed by idle bytes that keep
+   the bus busy for that long instead of the CPU.
+----------------------------------------------------*/
+#define PCF_RS   0x01
+#define PCF_EN   0x04
+#define PCF_BL   0x08
+#define LCD_SLOW_PAD 72             // idle bytes ~ 1.6 ms at 400 kHz
+
+volatile uint8_t i2cQ[I2C_QLEN];
+volatile uint8_t i2cHead = 0, i2cTail = 0;   // main writes head, ISR tail
+volatile uint8_t i2cBusy = 0;
+volatile uint32_t i2cNacks = 0;
+ISR_STATS_DEF(i2c2Stats, "I2C2 LCD");               // exit cycles only
+
+/* SCL counts for I2C_RATE_HZ from PCLK (CCLK/4). The period is rounded
+   up, so SCL never runs fast, and split 40/60 high/low: Fast-mode needs
+   tLOW >= 1.3 us but tHIGH only >= 0.6 us, and 50/50 at 400 kHz leaves
+   tLOW at 1.25 us. 25 MHz: 25 + 38 (397 kHz), 5 MHz: 5 + 8 (385 kHz). */
+void i2c_set_rate(void){
+    uint32_t pclk = SystemCoreClock / 4;
+    uint32_t total = (pclk + I2C_RATE_HZ - 1) / I2C_RATE_HZ, high;
+    if(total < 8) total = 8;                            // min 4 each
+    high = total * 2 / 5;
+    if(high < 4) high = 4;
+    LPC_I2C2->I2SCLH = high;
+    LPC_I2C2->I2SCLL = total - high;
+}
+
+void i2c_init(void){
+    LPC_SC->PCONP |= (1 << 26);                         // Power I2C2
+    LPC_PINCON->PINSEL0 = (LPC_PINCON->PINSEL0 & ~(0xF << 20)) | (0xA << 20); // P0.10 SDA2, P0.11 SCL2
+    LPC_PINCON->PINMODE0 = (LPC_PINCON->PINMODE0 & ~(0xF << 20)) | (0xA << 20); // no pull (external)
+    LPC_PINCON->PINMODE_OD0 |= (3 << 10);                // open drain
+    i2c_set_rate();
+    LPC_I2C2->I2CONCLR = 0x6C;                          // clear AA, SI, STA, I2EN
+    LPC_I2C2->I2CONSET = 0x40;                          // I2EN, master only
+    NVIC_EnableIRQ(I2C2_IRQn);
+}
+
+void I2C2_IRQHandler(void){
+    ISR_ENTRY(t0);
+    switch(LPC_I2C2->I2STAT){
+        case 0x08:                                      // START sent
+        case 0x10:                                      // repeated START sent
+            LPC_I2C2->I2DAT = PCF8574_ADDR << 1;        // SLA+W
+            LPC_I2C2->I2CONCLR = 0x20;                  // clear STA
+            break;
+        case 0x18:                                      // SLA+W ACKed
+        case 0x28:                                      // data ACKed
+            if(i2cTail != i2cHead){
+                LPC_I2C2->I2DAT = i2cQ[i2cTail];
+                i2cTail++;
+            }
+            else{
+                LPC_I2C2->I2CONSET = 0x10;              // STOP, queue drained
+                i2cBusy = 0;
+            }
+            break;
+        default:                                        // NACK / arbitration
+            i2cNacks++;
+            LPC_I2C2->I2CONSET = 0x10;
+            LPC_I2C2->I2CONCLR = 0x20;
+            i2cBusy = 0;
+            break;
+    }
+    LPC_I2C2->I2CONCLR = 0x08;                          // clear SI
+    ISR_EXIT(i2c2Stats, ISR_LAT_NONE, t0);
+}
+
+void i2c_put(uint8_t b){
+    while((uint8_t)(i2cHead + 1) == i2cTail) I2C_WAIT(); // full: let ISR drain
+    i2cQ[i2cHead] = b;
+    i2cHead++;
+    if(!i2cBusy){
+        i2cBusy = 1;
+        LPC_I2C2->I2CONSET = 0x20;                      // START
+    }
+}
+
+void i2c_flush(void){ while(i2cBusy) I2C_WAIT(); }
+
+void lcd_write_nibble(unsigned char nibble, unsigned char rs){
+    uint8_t b = (nibble << 4) | PCF_BL | rs;
+    i2c_put(b | PCF_EN);
+    i2c_put(b);                                         // falling EN latches
+}
+
+void lcd_write_byte(unsigned char val, int is_data){
+    unsigned char rs = is_data ? PCF_RS : 0, n;
+    lcd_write_nibble(val >> 4, rs);
+    lcd_write_nibble(val & 0x0F, rs);
+    if(!is_data && val <= 0x03)                          // clear / home
+        for(n = 0; n < LCD_SLOW_PAD; n++) i2c_put(PCF_BL);
+}
+
+void lcd_cmd(unsigned char c){ lcd_write_byte(c,0); }
+void lcd_data(unsigned char c){ lcd_write_byte(c,1); }
+
+/* HD44780 initialisation by instruction: three 8-bit function sets
+   (0x3 nibbles) with > 4.1 ms after the first and > 100 us after the
+   second, then 0x2 for 4-bit mode. Each wait starts after i2c_flush(),
+   i.e. once the strobe has left the bus. */
+void lcd_init(void){
+    i2c_init();
+    LCD_DELAY_US(40000);                                // > 40 ms after VCC
+    lcd_write_nibble(0x3, 0); i2c_flush(); LCD_DELAY_US(4100);
+    lcd_write_nibble(0x3, 0); i2c_flush(); LCD_DELAY_US(100);
+    lcd_write_nibble(0x3, 0);
+    lcd_write_nibble(0x2, 0);
+    lcd_cmd(0x28);   // 4-bit, 2-line
+    lcd_cmd(0x0C);   // Display ON, Cursor OFF
+    lcd_cmd(0x06);   // Entry mode
+    lcd_cmd(0x01);   // Clear
+}
+
+#endif
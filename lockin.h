@@ -0,0 +1,58 @@
+/* ---------- Lock-in demodulator ----------
+   Integer I/Q demodulation of beam samples taken at exactly 4 x the laser
+   modulation frequency. Used by the lock-in ADC_IRQHandler in
+   SILENT_INTRUDER_ALERT.c and by the host simulation in Lockin/, so the
+   SNR figures measured there come from the code the board runs. No
+   register access here.
+-------------------------------------------*/
+#ifndef LOCKIN_H
+#define LOCKIN_H
+
+#include <stdint.h>
+
+typedef struct {
+    int32_t  accI, accQ;            // running sums over the window
+    uint32_t accDC;
+    uint8_t  phase, count;          // sample in the period, periods done
+    int32_t  winI, winQ;            // last complete window
+    uint32_t winDC;                 // its mean level (ambient + laser / 2)
+} lockin_acc;
+
+static inline void lockin_reset(lockin_acc *a){
+    a->accI = a->accQ = 0;
+    a->accDC = 0;
+    a->phase = a->count = 0;
+}
+
+/* One sample in, +1/0/-1 weights:
+       I = s0 - s2,  Q = s1 - s3   (summed over `cycles` periods)
+   Returns 1 when a window is complete; the result is then in winI / winQ
+   / winDC until the next one. Always inlined: the ISR runs from SRAM. */
+static inline __attribute__((always_inline))
+int lockin_sample(lockin_acc *a, int x, unsigned int cycles){
+    switch(a->phase){
+        case 0: a->accI += x; break;
+        case 1: a->accQ += x; break;
+        case 2: a->accI -= x; break;
+        default: a->accQ -= x; break;
+    }
+    a->accDC += x;
+    a->phase = (a->phase + 1) & 3;
+
+    if(a->phase == 0 && ++a->count == cycles){
+        a->winI = a->accI; a->winQ = a->accQ;
+        a->winDC = a->accDC / (4 * cycles);
+        lockin_reset(a);
+        return 1;
+    }
+    return 0;
+}
+
+/* |I,Q| ~ max + min/2 (within 12 %), scaled to counts per period */
+static inline unsigned int lockin_amplitude(int32_t i, int32_t q, unsigned int cycles){
+    uint32_t a = (i < 0) ? -i : i, b = (q < 0) ? -q : q, t;
+    if(a < b){ t = a; a = b; b = t; }
+    return (a + b / 2) / cycles;
+}
+
+#endif
@@ -0,0 +1,23 @@
+/* ---------- Code in SRAM ----------
+   RAMFUNC places a routine in section ".ramfunc" (on-chip SRAM), where it
+   runs with no flash wait states or accelerator misses. The startup code
+   copies it with .data; see README.md for the linker/scatter line.
+   Define ISR_IN_RAM 0 before including this to build RAMFUNC code in
+   flash instead (the "before" measurement).
+-------------------------------------*/
+#ifndef RAMFUNC_H
+#define RAMFUNC_H
+
+#ifndef ISR_IN_RAM
+#define ISR_IN_RAM 1
+#endif
+
+#if !ISR_IN_RAM
+#define RAMFUNC
+#elif defined(__GNUC__) && !defined(__ARMCC_VERSION)
+#define RAMFUNC __attribute__((section(".ramfunc"), long_call, noinline))
+#else
+#define RAMFUNC __attribute__((section(".ramfunc")))
+#endif
+
+#endif
@@ -0,0 +1,263 @@
+/* Generated by Tone/gen_tones.c - do not edit, regenerate instead */
+#ifndef TONE_TABLES_H
+#define TONE_TABLES_H
+
+#include <stdint.h>
+
+#define TONE_FS     16000
+#define TONE_BLOCK  128          // samples per table (8 ms)
+#define TONE_TABLES 13
+
+#define TONE_T_SILENCE 0
+#define TONE_T_625     1
+#define TONE_T_750     2
+#define TONE_T_875     3
+#define TONE_T_1000    4
+#define TONE_T_1125    5
+#define TONE_T_1250    6
+#define TONE_T_1375    7
+#define TONE_T_2000    8
+#define TONE_T_2500    9
+#define TONE_T_3000    10
+#define TONE_T_DUAL_A  11
+#define TONE_T_DUAL_B  12
+
+/* In SRAM (not const) so GPDMA reads them without touching flash */
+uint32_t toneTable[TONE_TABLES][TONE_BLOCK] = {
+    { /* TONE_T_SILENCE */
+        0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000,
+        0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000,
+        0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000,
+        0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000,
+        0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000,
+        0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000,
+        0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000,
+        0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000,
+        0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000,
+        0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000,
+        0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000,
+        0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000,
+        0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000,
+        0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000,
+        0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000,
+        0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000
+    },
+    { /* TONE_T_625 */
+        0x8000, 0x9D40, 0xB880, 0xD080, 0xE3C0, 0xF100, 0xF780, 0xF6C0,
+        0xEEC0, 0xE080, 0xCC40, 0xB340, 0x9780, 0x7A00, 0x5D40, 0x4240,
+        0x2B40, 0x1900, 0x0D40, 0x0840, 0x0A40, 0x1380, 0x2340, 0x3880,
+        0x5200, 0x6E80, 0x8BC0, 0xA880, 0xC2C0, 0xD900, 0xE9C0, 0xF480,
+        0xF800, 0xF480, 0xE9C0, 0xD900, 0xC2C0, 0xA880, 0x8BC0, 0x6E80,
+        0x5200, 0x3880, 0x2340, 0x1380, 0x0A40, 0x0840, 0x0D40, 0x1900,
+        0x2B40, 0x4240, 0x5D40, 0x7A00, 0x9780, 0xB340, 0xCC40, 0xE080,
+        0xEEC0, 0xF6C0, 0xF780, 0xF100, 0xE3C0, 0xD080, 0xB880, 0x9D40,
+        0x8000, 0x62C0, 0x4780, 0x2F80, 0x1C40, 0x0F00, 0x0880, 0x0940,
+        0x1140, 0x1F80, 0x33C0, 0x4CC0, 0x6880, 0x8600, 0xA2C0, 0xBDC0,
+        0xD4C0, 0xE700, 0xF2C0, 0xF7C0, 0xF5C0, 0xEC80, 0xDCC0, 0xC780,
+        0xAE00, 0x9180, 0x7440, 0x5780, 0x3D40, 0x2700, 0x1640, 0x0B80,
+        0x0800, 0x0B80, 0x1640, 0x2700, 0x3D40, 0x5780, 0x7440, 0x9180,
+        0xAE00, 0xC780, 0xDCC0, 0xEC80, 0xF5C0, 0xF7C0, 0xF2C0, 0xE700,
+        0xD4C0, 0xBDC0, 0xA2C0, 0x8600, 0x6880, 0x4CC0, 0x33C0, 0x1F80,
+        0x1140, 0x0940, 0x0880, 0x0F00, 0x1C40, 0x2F80, 0x4780, 0x62C0
+    },
+    { /* TONE_T_750 */
+        0x8000, 0xA2C0, 0xC2C0, 0xDCC0, 0xEEC0, 0xF780, 0xF5C0, 0xE9C0,
+        0xD4C0, 0xB880, 0x9780, 0x7440, 0x5200, 0x33C0, 0x1C40, 0x0D40,
+        0x0800, 0x0D40, 0x1C40, 0x33C0, 0x5200, 0x7440, 0x9780, 0xB880,
+        0xD4C0, 0xE9C0, 0xF5C0, 0xF780, 0xEEC0, 0xDCC0, 0xC2C0, 0xA2C0,
+        0x8000, 0x5D40, 0x3D40, 0x2340, 0x1140, 0x0880, 0x0A40, 0x1640,
+        0x2B40, 0x4780, 0x6880, 0x8BC0, 0xAE00, 0xCC40, 0xE3C0, 0xF2C0,
+        0xF800, 0xF2C0, 0xE3C0, 0xCC40, 0xAE00, 0x8BC0, 0x6880, 0x4780,
+        0x2B40, 0x1640, 0x0A40, 0x0880, 0x1140, 0x2340, 0x3D40, 0x5D40,
+        0x8000, 0xA2C0, 0xC2C0, 0xDCC0, 0xEEC0, 0xF780, 0xF5C0, 0xE9C0,
+        0xD4C0, 0xB880, 0x9780, 0x7440, 0x5200, 0x33C0, 0x1C40, 0x0D40,
+        0x0800, 0x0D40, 0x1C40, 0x33C0, 0x5200, 0x7440, 0x9780, 0xB880,
+        0xD4C0, 0xE9C0, 0xF5C0, 0xF780, 0xEEC0, 0xDCC0, 0xC2C0, 0xA2C0,
+        0x8000, 0x5D40, 0x3D40, 0x2340, 0x1140, 0x0880, 0x0A40, 0x1640,
+        0x2B40, 0x4780, 0x6880, 0x8BC0, 0xAE00, 0xCC40, 0xE3C0, 0xF2C0,
+        0xF800, 0xF2C0, 0xE3C0, 0xCC40, 0xAE00, 0x8BC0, 0x6880, 0x4780,
+        0x2B40, 0x1640, 0x0A40, 0x0880, 0x1140, 0x2340, 0x3D40, 0x5D40
+    },
+    { /* TONE_T_875 */
+        0x8000, 0xA880, 0xCC40, 0xE700, 0xF5C0, 0xF6C0, 0xE9C0, 0xD080,
+        0xAE00, 0x8600, 0x5D40, 0x3880, 0x1C40, 0x0B80, 0x0880, 0x1380,
+        0x2B40, 0x4CC0, 0x7440, 0x9D40, 0xC2C0, 0xE080, 0xF2C0, 0xF7C0,
+        0xEEC0, 0xD900, 0xB880, 0x9180, 0x6880, 0x4240, 0x2340, 0x0F00,
+        0x0800, 0x0F00, 0x2340, 0x4240, 0x6880, 0x9180, 0xB880, 0xD900,
+        0xEEC0, 0xF7C0, 0xF2C0, 0xE080, 0xC2C0, 0x9D40, 0x7440, 0x4CC0,
+        0x2B40, 0x1380, 0x0880, 0x0B80, 0x1C40, 0x3880, 0x5D40, 0x8600,
+        0xAE00, 0xD080, 0xE9C0, 0xF6C0, 0xF5C0, 0xE700, 0xCC40, 0xA880,
+        0x8000, 0x5780, 0x33C0, 0x1900, 0x0A40, 0x0940, 0x1640, 0x2F80,
+        0x5200, 0x7A00, 0xA2C0, 0xC780, 0xE3C0, 0xF480, 0xF780, 0xEC80,
+        0xD4C0, 0xB340, 0x8BC0, 0x62C0, 0x3D40, 0x1F80, 0x0D40, 0x0840,
+        0x1140, 0x2700, 0x4780, 0x6E80, 0x9780, 0xBDC0, 0xDCC0, 0xF100,
+        0xF800, 0xF100, 0xDCC0, 0xBDC0, 0x9780, 0x6E80, 0x4780, 0x2700,
+        0x1140, 0x0840, 0x0D40, 0x1F80, 0x3D40, 0x62C0, 0x8BC0, 0xB340,
+        0xD4C0, 0xEC80, 0xF780, 0xF480, 0xE3C0, 0xC780, 0xA2C0, 0x7A00,
+        0x5200, 0x2F80, 0x1640, 0x0940, 0x0A40, 0x1900, 0x33C0, 0x5780
+    },
+    { /* TONE_T_1000 */
+        0x8000, 0xAE00, 0xD4C0, 0xEEC0, 0xF800, 0xEEC0, 0xD4C0, 0xAE00,
+        0x8000, 0x5200, 0x2B40, 0x1140, 0x0800, 0x1140, 0x2B40, 0x5200,
+        0x8000, 0xAE00, 0xD4C0, 0xEEC0, 0xF800, 0xEEC0, 0xD4C0, 0xAE00,
+        0x8000, 0x5200, 0x2B40, 0x1140, 0x0800, 0x1140, 0x2B40, 0x5200,
+        0x8000, 0xAE00, 0xD4C0, 0xEEC0, 0xF800, 0xEEC0, 0xD4C0, 0xAE00,
+        0x8000, 0x5200, 0x2B40, 0x1140, 0x0800, 0x1140, 0x2B40, 0x5200,
+        0x8000, 0xAE00, 0xD4C0, 0xEEC0, 0xF800, 0xEEC0, 0xD4C0, 0xAE00,
+        0x8000, 0x5200, 0x2B40, 0x1140, 0x0800, 0x1140, 0x2B40, 0x5200,
+        0x8000, 0xAE00, 0xD4C0, 0xEEC0, 0xF800, 0xEEC0, 0xD4C0, 0xAE00,
+        0x8000, 0x5200, 0x2B40, 0x1140, 0x0800, 0x1140, 0x2B40, 0x5200,
+        0x8000, 0xAE00, 0xD4C0, 0xEEC0, 0xF800, 0xEEC0, 0xD4C0, 0xAE00,
+        0x8000, 0x5200, 0x2B40, 0x1140, 0x0800, 0x1140, 0x2B40, 0x5200,
+        0x8000, 0xAE00, 0xD4C0, 0xEEC0, 0xF800, 0xEEC0, 0xD4C0, 0xAE00,
+        0x8000, 0x5200, 0x2B40, 0x1140, 0x0800, 0x1140, 0x2B40, 0x5200,
+        0x8000, 0xAE00, 0xD4C0, 0xEEC0, 0xF800, 0xEEC0, 0xD4C0, 0xAE00,
+        0x8000, 0x5200, 0x2B40, 0x1140, 0x0800, 0x1140, 0x2B40, 0x5200
+    },
+    { /* TONE_T_1125 */
+        0x8000, 0xB340, 0xDCC0, 0xF480, 0xF5C0, 0xE080, 0xB880, 0x8600,
+        0x5200, 0x2700, 0x0D40, 0x0940, 0x1C40, 0x4240, 0x7440, 0xA880,
+        0xD4C0, 0xF100, 0xF780, 0xE700, 0xC2C0, 0x9180, 0x5D40, 0x2F80,
+        0x1140, 0x0840, 0x1640, 0x3880, 0x6880, 0x9D40, 0xCC40, 0xEC80,
+        0xF800, 0xEC80, 0xCC40, 0x9D40, 0x6880, 0x3880, 0x1640, 0x0840,
+        0x1140, 0x2F80, 0x5D40, 0x9180, 0xC2C0, 0xE700, 0xF780, 0xF100,
+        0xD4C0, 0xA880, 0x7440, 0x4240, 0x1C40, 0x0940, 0x0D40, 0x2700,
+        0x5200, 0x8600, 0xB880, 0xE080, 0xF5C0, 0xF480, 0xDCC0, 0xB340,
+        0x8000, 0x4CC0, 0x2340, 0x0B80, 0x0A40, 0x1F80, 0x4780, 0x7A00,
+        0xAE00, 0xD900, 0xF2C0, 0xF6C0, 0xE3C0, 0xBDC0, 0x8BC0, 0x5780,
+        0x2B40, 0x0F00, 0x0880, 0x1900, 0x3D40, 0x6E80, 0xA2C0, 0xD080,
+        0xEEC0, 0xF7C0, 0xE9C0, 0xC780, 0x9780, 0x62C0, 0x33C0, 0x1380,
+        0x0800, 0x1380, 0x33C0, 0x62C0, 0x9780, 0xC780, 0xE9C0, 0xF7C0,
+        0xEEC0, 0xD080, 0xA2C0, 0x6E80, 0x3D40, 0x1900, 0x0880, 0x0F00,
+        0x2B40, 0x5780, 0x8BC0, 0xBDC0, 0xE3C0, 0xF6C0, 0xF2C0, 0xD900,
+        0xAE00, 0x7A00, 0x4780, 0x1F80, 0x0A40, 0x0B80, 0x2340, 0x4CC0
+    },
+    { /* TONE_T_1250 */
+        0x8000, 0xB880, 0xE3C0, 0xF780, 0xEEC0, 0xCC40, 0x9780, 0x5D40,
+        0x2B40, 0x0D40, 0x0A40, 0x2340, 0x5200, 0x8BC0, 0xC2C0, 0xE9C0,
+        0xF800, 0xE9C0, 0xC2C0, 0x8BC0, 0x5200, 0x2340, 0x0A40, 0x0D40,
+        0x2B40, 0x5D40, 0x9780, 0xCC40, 0xEEC0, 0xF780, 0xE3C0, 0xB880,
+        0x8000, 0x4780, 0x1C40, 0x0880, 0x1140, 0x33C0, 0x6880, 0xA2C0,
+        0xD4C0, 0xF2C0, 0xF5C0, 0xDCC0, 0xAE00, 0x7440, 0x3D40, 0x1640,
+        0x0800, 0x1640, 0x3D40, 0x7440, 0xAE00, 0xDCC0, 0xF5C0, 0xF2C0,
+        0xD4C0, 0xA2C0, 0x6880, 0x33C0, 0x1140, 0x0880, 0x1C40, 0x4780,
+        0x8000, 0xB880, 0xE3C0, 0xF780, 0xEEC0, 0xCC40, 0x9780, 0x5D40,
+        0x2B40, 0x0D40, 0x0A40, 0x2340, 0x5200, 0x8BC0, 0xC2C0, 0xE9C0,
+        0xF800, 0xE9C0, 0xC2C0, 0x8BC0, 0x5200, 0x2340, 0x0A40, 0x0D40,
+        0x2B40, 0x5D40, 0x9780, 0xCC40, 0xEEC0, 0xF780, 0xE3C0, 0xB880,
+        0x8000, 0x4780, 0x1C40, 0x0880, 0x1140, 0x33C0, 0x6880, 0xA2C0,
+        0xD4C0, 0xF2C0, 0xF5C0, 0xDCC0, 0xAE00, 0x7440, 0x3D40, 0x1640,
+        0x0800, 0x1640, 0x3D40, 0x7440, 0xAE00, 0xDCC0, 0xF5C0, 0xF2C0,
+        0xD4C0, 0xA2C0, 0x6880, 0x33C0, 0x1140, 0x0880, 0x1C40, 0x4780
+    },
+    { /* TONE_T_1375 */
+        0x8000, 0xBDC0, 0xE9C0, 0xF7C0, 0xE3C0, 0xB340, 0x7440, 0x3880,
+        0x1140, 0x0940, 0x2340, 0x5780, 0x9780, 0xD080, 0xF2C0, 0xF480,
+        0xD4C0, 0x9D40, 0x5D40, 0x2700, 0x0A40, 0x0F00, 0x33C0, 0x6E80,
+        0xAE00, 0xE080, 0xF780, 0xEC80, 0xC2C0, 0x8600, 0x4780, 0x1900,
+        0x0800, 0x1900, 0x4780, 0x8600, 0xC2C0, 0xEC80, 0xF780, 0xE080,
+        0xAE00, 0x6E80, 0x33C0, 0x0F00, 0x0A40, 0x2700, 0x5D40, 0x9D40,
+        0xD4C0, 0xF480, 0xF2C0, 0xD080, 0x9780, 0x5780, 0x2340, 0x0940,
+        0x1140, 0x3880, 0x7440, 0xB340, 0xE3C0, 0xF7C0, 0xE9C0, 0xBDC0,
+        0x8000, 0x4240, 0x1640, 0x0840, 0x1C40, 0x4CC0, 0x8BC0, 0xC780,
+        0xEEC0, 0xF6C0, 0xDCC0, 0xA880, 0x6880, 0x2F80, 0x0D40, 0x0B80,
+        0x2B40, 0x62C0, 0xA2C0, 0xD900, 0xF5C0, 0xF100, 0xCC40, 0x9180,
+        0x5200, 0x1F80, 0x0880, 0x1380, 0x3D40, 0x7A00, 0xB880, 0xE700,
+        0xF800, 0xE700, 0xB880, 0x7A00, 0x3D40, 0x1380, 0x0880, 0x1F80,
+        0x5200, 0x9180, 0xCC40, 0xF100, 0xF5C0, 0xD900, 0xA2C0, 0x62C0,
+        0x2B40, 0x0B80, 0x0D40, 0x2F80, 0x6880, 0xA880, 0xDCC0, 0xF6C0,
+        0xEEC0, 0xC780, 0x8BC0, 0x4CC0, 0x1C40, 0x0840, 0x1640, 0x4240
+    },
+    { /* TONE_T_2000 */
+        0x8000, 0xD4C0, 0xF800, 0xD4C0, 0x8000, 0x2B40, 0x0800, 0x2B40,
+        0x8000, 0xD4C0, 0xF800, 0xD4C0, 0x8000, 0x2B40, 0x0800, 0x2B40,
+        0x8000, 0xD4C0, 0xF800, 0xD4C0, 0x8000, 0x2B40, 0x0800, 0x2B40,
+        0x8000, 0xD4C0, 0xF800, 0xD4C0, 0x8000, 0x2B40, 0x0800, 0x2B40,
+        0x8000, 0xD4C0, 0xF800, 0xD4C0, 0x8000, 0x2B40, 0x0800, 0x2B40,
+        0x8000, 0xD4C0, 0xF800, 0xD4C0, 0x8000, 0x2B40, 0x0800, 0x2B40,
+        0x8000, 0xD4C0, 0xF800, 0xD4C0, 0x8000, 0x2B40, 0x0800, 0x2B40,
+        0x8000, 0xD4C0, 0xF800, 0xD4C0, 0x8000, 0x2B40, 0x0800, 0x2B40,
+        0x8000, 0xD4C0, 0xF800, 0xD4C0, 0x8000, 0x2B40, 0x0800, 0x2B40,
+        0x8000, 0xD4C0, 0xF800, 0xD4C0, 0x8000, 0x2B40, 0x0800, 0x2B40,
+        0x8000, 0xD4C0, 0xF800, 0xD4C0, 0x8000, 0x2B40, 0x0800, 0x2B40,
+        0x8000, 0xD4C0, 0xF800, 0xD4C0, 0x8000, 0x2B40, 0x0800, 0x2B40,
+        0x8000, 0xD4C0, 0xF800, 0xD4C0, 0x8000, 0x2B40, 0x0800, 0x2B40,
+        0x8000, 0xD4C0, 0xF800, 0xD4C0, 0x8000, 0x2B40, 0x0800, 0x2B40,
+        0x8000, 0xD4C0, 0xF800, 0xD4C0, 0x8000, 0x2B40, 0x0800, 0x2B40,
+        0x8000, 0xD4C0, 0xF800, 0xD4C0, 0x8000, 0x2B40, 0x0800, 0x2B40
+    },
+    { /* TONE_T_2500 */
+        0x8000, 0xE3C0, 0xEEC0, 0x9780, 0x2B40, 0x0A40, 0x5200, 0xC2C0,
+        0xF800, 0xC2C0, 0x5200, 0x0A40, 0x2B40, 0x9780, 0xEEC0, 0xE3C0,
+        0x8000, 0x1C40, 0x1140, 0x6880, 0xD4C0, 0xF5C0, 0xAE00, 0x3D40,
+        0x0800, 0x3D40, 0xAE00, 0xF5C0, 0xD4C0, 0x6880, 0x1140, 0x1C40,
+        0x8000, 0xE3C0, 0xEEC0, 0x9780, 0x2B40, 0x0A40, 0x5200, 0xC2C0,
+        0xF800, 0xC2C0, 0x5200, 0x0A40, 0x2B40, 0x9780, 0xEEC0, 0xE3C0,
+        0x8000, 0x1C40, 0x1140, 0x6880, 0xD4C0, 0xF5C0, 0xAE00, 0x3D40,
+        0x0800, 0x3D40, 0xAE00, 0xF5C0, 0xD4C0, 0x6880, 0x1140, 0x1C40,
+        0x8000, 0xE3C0, 0xEEC0, 0x9780, 0x2B40, 0x0A40, 0x5200, 0xC2C0,
+        0xF800, 0xC2C0, 0x5200, 0x0A40, 0x2B40, 0x9780, 0xEEC0, 0xE3C0,
+        0x8000, 0x1C40, 0x1140, 0x6880, 0xD4C0, 0xF5C0, 0xAE00, 0x3D40,
+        0x0800, 0x3D40, 0xAE00, 0xF5C0, 0xD4C0, 0x6880, 0x1140, 0x1C40,
+        0x8000, 0xE3C0, 0xEEC0, 0x9780, 0x2B40, 0x0A40, 0x5200, 0xC2C0,
+        0xF800, 0xC2C0, 0x5200, 0x0A40, 0x2B40, 0x9780, 0xEEC0, 0xE3C0,
+        0x8000, 0x1C40, 0x1140, 0x6880, 0xD4C0, 0xF5C0, 0xAE00, 0x3D40,
+        0x0800, 0x3D40, 0xAE00, 0xF5C0, 0xD4C0, 0x6880, 0x1140, 0x1C40
+    },
+    { /* TONE_T_3000 */
+        0x8000, 0xEEC0, 0xD4C0, 0x5200, 0x0800, 0x5200, 0xD4C0, 0xEEC0,
+        0x8000, 0x1140, 0x2B40, 0xAE00, 0xF800, 0xAE00, 0x2B40, 0x1140,
+        0x8000, 0xEEC0, 0xD4C0, 0x5200, 0x0800, 0x5200, 0xD4C0, 0xEEC0,
+        0x8000, 0x1140, 0x2B40, 0xAE00, 0xF800, 0xAE00, 0x2B40, 0x1140,
+        0x8000, 0xEEC0, 0xD4C0, 0x5200, 0x0800, 0x5200, 0xD4C0, 0xEEC0,
+        0x8000, 0x1140, 0x2B40, 0xAE00, 0xF800, 0xAE00, 0x2B40, 0x1140,
+        0x8000, 0xEEC0, 0xD4C0, 0x5200, 0x0800, 0x5200, 0xD4C0, 0xEEC0,
+        0x8000, 0x1140, 0x2B40, 0xAE00, 0xF800, 0xAE00, 0x2B40, 0x1140,
+        0x8000, 0xEEC0, 0xD4C0, 0x5200, 0x0800, 0x5200, 0xD4C0, 0xEEC0,
+        0x8000, 0x1140, 0x2B40, 0xAE00, 0xF800, 0xAE00, 0x2B40, 0x1140,
+        0x8000, 0xEEC0, 0xD4C0, 0x5200, 0x0800, 0x5200, 0xD4C0, 0xEEC0,
+        0x8000, 0x1140, 0x2B40, 0xAE00, 0xF800, 0xAE00, 0x2B40, 0x1140,
+        0x8000, 0xEEC0, 0xD4C0, 0x5200, 0x0800, 0x5200, 0xD4C0, 0xEEC0,
+        0x8000, 0x1140, 0x2B40, 0xAE00, 0xF800, 0xAE00, 0x2B40, 0x1140,
+        0x8000, 0xEEC0, 0xD4C0, 0x5200, 0x0800, 0x5200, 0xD4C0, 0xEEC0,
+        0x8000, 0x1140, 0x2B40, 0xAE00, 0xF800, 0xAE00, 0x2B40, 0x1140
+    },
+    { /* TONE_T_DUAL_A */
+        0x8000, 0xAB00, 0xCFC0, 0xE880, 0xF240, 0xEC00, 0xD740, 0xB7C0,
+        0x9380, 0x6FC0, 0x5240, 0x3EC0, 0x3740, 0x3B00, 0x4840, 0x5AC0,
+        0x6E80, 0x7F00, 0x89C0, 0x8D80, 0x8A40, 0x8300, 0x7A40, 0x7400,
+        0x7300, 0x7900, 0x8600, 0x9800, 0xABC0, 0xBD00, 0xC780, 0xC7C0,
+        0xBC00, 0xA4C0, 0x84C0, 0x6040, 0x3CC0, 0x2080, 0x1040, 0x0F40,
+        0x1E40, 0x3B80, 0x6300, 0x8EC0, 0xB840, 0xD980, 0xED80, 0xF200,
+        0xE680, 0xCDC0, 0xAC00, 0x8740, 0x6500, 0x4A80, 0x3B00, 0x3740,
+        0x3E80, 0x4E00, 0x6180, 0x7480, 0x8380, 0x8BC0, 0x8D00, 0x8840,
+        0x8000, 0x77C0, 0x7300, 0x7440, 0x7C80, 0x8B80, 0x9E80, 0xB200,
+        0xC180, 0xC8C0, 0xC500, 0xB580, 0x9B00, 0x78C0, 0x5400, 0x3240,
+        0x1980, 0x0E00, 0x1280, 0x2680, 0x47C0, 0x7140, 0x9D00, 0xC480,
+        0xE1C0, 0xF0C0, 0xEFC0, 0xDF80, 0xC340, 0x9FC0, 0x7B40, 0x5B40,
+        0x4400, 0x3840, 0x3880, 0x4300, 0x5440, 0x6800, 0x7A00, 0x8700,
+        0x8D00, 0x8C00, 0x85C0, 0x7D00, 0x75C0, 0x7280, 0x7640, 0x8100,
+        0x9180, 0xA540, 0xB7C0, 0xC500, 0xC8C0, 0xC140, 0xADC0, 0x9040,
+        0x6C80, 0x4840, 0x28C0, 0x1400, 0x0DC0, 0x1780, 0x3040, 0x5500
+    },
+    { /* TONE_T_DUAL_B */
+        0x8000, 0xB300, 0xDB00, 0xEF80, 0xECC0, 0xD500, 0xAF00, 0x8480,
+        0x5F80, 0x4780, 0x4040, 0x4800, 0x59C0, 0x6E00, 0x7DC0, 0x8400,
+        0x8000, 0x7500, 0x68C0, 0x6200, 0x6680, 0x77C0, 0x9340, 0xB300,
+        0xCE80, 0xDCC0, 0xD800, 0xBF00, 0x95C0, 0x6400, 0x3540, 0x1400,
+        0x0800, 0x1400, 0x3540, 0x6400, 0x95C0, 0xBF00, 0xD800, 0xDCC0,
+        0xCE80, 0xB300, 0x9340, 0x77C0, 0x6680, 0x6200, 0x68C0, 0x7500,
+        0x8000, 0x8400, 0x7DC0, 0x6E00, 0x59C0, 0x4800, 0x4040, 0x4780,
+        0x5F80, 0x8480, 0xAF00, 0xD500, 0xECC0, 0xEF80, 0xDB00, 0xB300,
+        0x8000, 0x4D00, 0x2500, 0x1080, 0x1340, 0x2B00, 0x5100, 0x7B80,
+        0xA080, 0xB880, 0xBFC0, 0xB800, 0xA640, 0x9200, 0x8240, 0x7C00,
+        0x8000, 0x8B00, 0x9740, 0x9E00, 0x9980, 0x8840, 0x6CC0, 0x4D00,
+        0x3180, 0x2340, 0x2800, 0x4100, 0x6A40, 0x9C00, 0xCAC0, 0xEC00,
+        0xF800, 0xEC00, 0xCAC0, 0x9C00, 0x6A40, 0x4100, 0x2800, 0x2340,
+        0x3180, 0x4D00, 0x6CC0, 0x8840, 0x9980, 0x9E00, 0x9740, 0x8B00,
+        0x8000, 0x7C00, 0x8240, 0x9200, 0xA640, 0xB800, 0xBFC0, 0xB880,
+        0xA080, 0x7B80, 0x5100, 0x2B00, 0x1340, 0x1080, 0x2500, 0x4D00
+    }
+};
+
+#endif
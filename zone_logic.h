@@ -0,0 +1,84 @@
+/* ---------- Zone trip logic ----------
+   One BURST scan in, tripped / broken bitmasks out. Used by the zone-mode
+   ADC_IRQHandler in SILENT_INTRUDER_ALERT.c and by the host replay tool in
+   Trace/, so a recorded trace reaches exactly the same alarm decisions on
+   the PC as on the board. No register access here.
+-------------------------------------*/
+#ifndef ZONE_LOGIC_H
+#define ZONE_LOGIC_H
+
+#include <stdint.h>
+
+#define ZONE_COUNT 8
+
+/* Runs the hysteresis / debounce for every channel in mask.
+   x: samples (counts), lo/hi: trip/restore thresholds, run: consecutive
+   broken scans per zone. Updates *broken, returns the zones that tripped
+   on this scan (caller ORs them into its alarm latch). Always inlined:
+   the zone ISR runs from SRAM and must not call into flash. */
+static inline __attribute__((always_inline))
+uint8_t zone_scan(uint8_t mask, uint16_t trip, const uint16_t *x,
+                  const uint16_t *lo, const uint16_t *hi,
+                  uint16_t *run, uint8_t *broken){
+    uint8_t b = *broken, tripped = 0, bit;
+    unsigned int z;
+
+    for(z = 0, bit = 1; z < ZONE_COUNT; z++, bit <<= 1){
+        if(!(mask & bit)) continue;
+        if(x[z] < lo[z]){
+            if(run[z] < trip && ++run[z] == trip){
+                b |= bit;
+                tripped |= bit;
+            }
+        }
+        else if(x[z] > hi[z]){
+            run[z] = 0;
+            b &= ~bit;
+        }
+    }
+    *broken = b;
+    return tripped;
+}
+
+/* One character per zone: '-' unused, 'o' ok, '#' broken, 'A' latched */
+static inline void zone_status_line(char *line, unsigned int cols, uint8_t mask,
+                                    uint8_t broken, uint8_t alarm){
+    unsigned int z;
+    uint8_t bit;
+
+    line[0] = 'Z'; line[1] = ':';
+    for(z = 0, bit = 1; z < ZONE_COUNT; z++, bit <<= 1){
+        if(!(mask & bit))     line[2 + z] = '-';
+        else if(broken & bit) line[2 + z] = '#';
+        else if(alarm & bit)  line[2 + z] = 'A';
+        else                  line[2 + z] = 'o';
+    }
+    for(z = 2 + ZONE_COUNT; z < cols; z++) line[z] = ' ';
+    line[cols] = '\0';
+}
+
+/* BURST scans per second: 65 ADC clocks per channel in mask */
+static inline uint16_t zone_scan_hz(uint32_t adc_clk, uint8_t mask){
+    unsigned int n = 0;
+    for(; mask; mask &= mask - 1) n++;
+    return n ? adc_clk / (65 * n) : 0;
+}
+
+/* ---------- Trace records ----------
+   Little-endian byte stream, every record starts with its type byte and
+   ends with an XOR checksum of all preceding bytes of the record.
+   'H' header : mask u8, trip u16, lo u16, hi u16, decim u8,
+                scan_hz u16 (BURST scans/s at the live ADC clock)    (12 B)
+   'S' scan   : seq u32 (scan number), inputs u8 (bit0 = SW1 pressed),
+                8 x u16 samples (unused zones 0)                     (23 B)
+   The board repeats 'H' after every TRACE_HDR_EVERY 'S' records, so a
+   capture started after reset is decodable from its first 'H' on.
+-------------------------------------*/
+#define TRACE_HDR       'H'
+#define TRACE_SCAN      'S'
+#define TRACE_HDR_LEN   12
+#define TRACE_SCAN_LEN  23
+#define TRACE_IN_SW1    0x01
+#define TRACE_HDR_EVERY 128
+
+#endif